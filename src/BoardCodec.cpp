@@ -0,0 +1,210 @@
+#include "BoardCodec.h"
+#include "sudokuboard.h"
+#include "data-structures/bitmask.h"
+
+#include <cstring>
+
+// Append a digit to a nibble stream (low nibble first)
+static void putDigit(uint8_t* digits, int index, int value) {
+    if (index % 2 == 0) {
+        digits[index / 2] = static_cast<uint8_t>(value);
+    } else {
+        digits[index / 2] |= static_cast<uint8_t>(value << 4);
+    }
+}
+
+size_t packBoard(const int clues[9][9], uint8_t* out) {
+    uint8_t* bitmap = out + 1;
+    uint8_t* digits = bitmap + PACKED_BITMAP_BYTES;
+    std::memset(bitmap, 0, PACKED_BITMAP_BYTES);
+
+    int count = 0;
+    for (int cell = 0; cell < 81; cell++) {
+        int value = clues[cell / 9][cell % 9];
+        if (value >= 1 && value <= 9) {
+            bitmap[cell / 8] |= static_cast<uint8_t>(1u << (cell % 8));
+            putDigit(digits, count++, value);
+        }
+    }
+
+    out[0] = PACKED_CLUES;
+    return 1 + PACKED_BITMAP_BYTES + (count + 1) / 2;
+}
+
+size_t packBoard(const int clues[9][9], const int solution[9][9], uint8_t* out) {
+    uint8_t* bitmap = out + 1;
+    uint8_t* digits = bitmap + PACKED_BITMAP_BYTES;
+    std::memset(bitmap, 0, PACKED_BITMAP_BYTES);
+
+    for (int cell = 0; cell < 81; cell++) {
+        int row = cell / 9;
+        int col = cell % 9;
+        int value = solution[row][col];
+        if (value < 1 || value > 9) {
+            return 0;
+        }
+        if (clues[row][col] != 0) {
+            if (clues[row][col] != value) {
+                return 0;
+            }
+            bitmap[cell / 8] |= static_cast<uint8_t>(1u << (cell % 8));
+        }
+        putDigit(digits, cell, value);
+    }
+
+    out[0] = PACKED_SOLVED;
+    return PACKED_SOLVED_SIZE;
+}
+
+size_t packBoard(const SudokuBoard& board, uint8_t* out) {
+    return packBoard(board.board, out);
+}
+
+PackedBoardView::PackedBoardView(const uint8_t* bytes, size_t size)
+    : data(bytes), length(size), clues(0), valid(false) {
+    if (data == nullptr || length < 1 + PACKED_BITMAP_BYTES) {
+        return;
+    }
+    if (data[0] != PACKED_CLUES && data[0] != PACKED_SOLVED) {
+        return;
+    }
+
+    // Cell 80 is bit 0 of the last bitmap byte; the rest must be clear
+    const uint8_t* bitmap = data + 1;
+    if ((bitmap[PACKED_BITMAP_BYTES - 1] & 0xFE) != 0) {
+        return;
+    }
+    for (int i = 0; i < PACKED_BITMAP_BYTES; i++) {
+        clues += countBits(bitmap[i]);
+    }
+
+    int digitCount = hasSolution() ? 81 : clues;
+    if (length < 1 + PACKED_BITMAP_BYTES + static_cast<size_t>((digitCount + 1) / 2)) {
+        return;
+    }
+    for (int i = 0; i < digitCount; i++) {
+        int value = digitAt(i);
+        if (value < 1 || value > 9) {
+            return;
+        }
+    }
+    valid = true;
+}
+
+bool PackedBoardView::isValid() const {
+    return valid;
+}
+
+size_t PackedBoardView::size() const {
+    if (!valid) {
+        return 0;
+    }
+    return 1 + PACKED_BITMAP_BYTES + ((hasSolution() ? 81 : clues) + 1) / 2;
+}
+
+bool PackedBoardView::hasSolution() const {
+    return data[0] == PACKED_SOLVED;
+}
+
+int PackedBoardView::clueCount() const {
+    return clues;
+}
+
+uint32_t PackedBoardView::clueBits(int word) const {
+    const uint8_t* bitmap = data + 1;
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; i++) {
+        int byte = word * 4 + i;
+        if (byte < PACKED_BITMAP_BYTES) {
+            bits |= static_cast<uint32_t>(bitmap[byte]) << (8 * i);
+        }
+    }
+    return bits;
+}
+
+bool PackedBoardView::isClue(int row, int col) const {
+    int cell = row * 9 + col;
+    return (data[1 + cell / 8] >> (cell % 8)) & 1;
+}
+
+int PackedBoardView::clue(int row, int col) const {
+    if (!isClue(row, col)) {
+        return 0;
+    }
+    int cell = row * 9 + col;
+    return hasSolution() ? digitAt(cell) : digitAt(clueRank(cell));
+}
+
+int PackedBoardView::solution(int row, int col) const {
+    return hasSolution() ? digitAt(row * 9 + col) : 0;
+}
+
+int PackedBoardView::clueDigit(int rank) const {
+    if (hasSolution() || rank < 0 || rank >= clues) {
+        return 0;
+    }
+    return digitAt(rank);
+}
+
+void PackedBoardView::unpackClues(int grid[9][9]) const {
+    std::memset(grid, 0, sizeof(int) * 81);
+    int count = 0;
+    for (int cell = 0; cell < 81; cell++) {
+        if ((data[1 + cell / 8] >> (cell % 8)) & 1) {
+            grid[cell / 9][cell % 9] = hasSolution() ? digitAt(cell) : digitAt(count);
+            count++;
+        }
+    }
+}
+
+bool PackedBoardView::unpackSolution(int grid[9][9]) const {
+    if (!hasSolution()) {
+        return false;
+    }
+    for (int cell = 0; cell < 81; cell++) {
+        grid[cell / 9][cell % 9] = digitAt(cell);
+    }
+    return true;
+}
+
+int PackedBoardView::digitAt(int index) const {
+    uint8_t pair = data[1 + PACKED_BITMAP_BYTES + index / 2];
+    return (index % 2 == 0) ? (pair & 0x0F) : (pair >> 4);
+}
+
+int PackedBoardView::clueRank(int cell) const {
+    const uint8_t* bitmap = data + 1;
+    int rank = 0;
+    for (int i = 0; i < cell / 8; i++) {
+        rank += countBits(bitmap[i]);
+    }
+    return rank + countBits(bitmap[cell / 8] & ((1u << (cell % 8)) - 1));
+}
+
+std::string encodeText(const int grid[9][9]) {
+    std::string text(81, '.');
+    for (int cell = 0; cell < 81; cell++) {
+        int value = grid[cell / 9][cell % 9];
+        if (value >= 1 && value <= 9) {
+            text[cell] = static_cast<char>('0' + value);
+        }
+    }
+    return text;
+}
+
+bool decodeText(const std::string& text, int grid[9][9]) {
+    if (text.size() != 81) {
+        return false;
+    }
+    for (int cell = 0; cell < 81; cell++) {
+        char ch = text[cell];
+        if (ch >= '1' && ch <= '9') {
+            grid[cell / 9][cell % 9] = ch - '0';
+        } else if (ch == '.' || ch == '0') {
+            grid[cell / 9][cell % 9] = 0;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+#ifndef BOARDCODEC_H
+#define BOARDCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+template <int BoxSize> class BasicSudokuBoard;
+typedef BasicSudokuBoard<3> SudokuBoard;
+
+// Compact binary encoding of a puzzle, optionally with its solution.
+//
+//   byte 0        format: PACKED_CLUES or PACKED_SOLVED
+//   bytes 1-11    clue bitmap, bit i set if cell i (row-major) is a given
+//   PACKED_CLUES  clue digits in cell order, two per byte (low nibble first)
+//   PACKED_SOLVED all 81 solution digits, two per byte; the clue digits are the
+//                 solution digits at the bitmap's cells, so they are not stored twice
+//
+// A puzzle takes 21 bytes (17 clues) to 53 bytes, and a puzzle with its solution always
+// takes PACKED_SOLVED_SIZE (53) bytes, against 324 bytes for an int[9][9].
+enum PackedFormat {
+    PACKED_CLUES = 1,
+    PACKED_SOLVED = 2
+};
+
+static const int PACKED_BITMAP_BYTES = 11;
+static const int PACKED_DIGIT_BYTES = 41;  // 81 digits, two per byte
+static const int PACKED_SOLVED_SIZE = 1 + PACKED_BITMAP_BYTES + PACKED_DIGIT_BYTES;
+static const int PACKED_MAX_SIZE = PACKED_SOLVED_SIZE;
+
+// Pack a puzzle (0 = empty cell) into out[PACKED_MAX_SIZE]; returns the bytes used.
+// With a solution, returns 0 if it is incomplete or disagrees with a clue.
+size_t packBoard(const int clues[9][9], uint8_t* out);
+size_t packBoard(const int clues[9][9], const int solution[9][9], uint8_t* out);
+
+// Pack the current values of a board as the clues
+size_t packBoard(const SudokuBoard& board, uint8_t* out);
+
+// Read-only view of a packed puzzle in someone else's buffer (no copy, no allocation)
+class PackedBoardView {
+public:
+    PackedBoardView(const uint8_t* bytes, size_t length);
+
+    // The buffer holds a complete, well-formed encoding
+    bool isValid() const;
+
+    // Bytes used by the encoding
+    size_t size() const;
+
+    bool hasSolution() const;
+    int clueCount() const;
+
+    // Clue bitmap word w covers cells 32w..32w+31 (cells 81+ are always clear)
+    uint32_t clueBits(int word) const;
+
+    bool isClue(int row, int col) const;
+
+    // Given digit of a cell (0 if not a clue)
+    int clue(int row, int col) const;
+
+    // Solution digit of a cell (0 if there is no solution)
+    int solution(int row, int col) const;
+
+    // Digit of the rank-th clue in cell order, for encodings without a solution (0 if
+    // there is a solution or rank is out of range); clue() without the rank lookup
+    int clueDigit(int rank) const;
+
+    void unpackClues(int grid[9][9]) const;
+    bool unpackSolution(int grid[9][9]) const;
+
+private:
+    const uint8_t* data;
+    size_t length;
+    int clues;
+    bool valid;
+
+    int digitAt(int index) const;  // Index-th packed digit after the bitmap
+    int clueRank(int cell) const;  // Number of clues before a cell
+};
+
+// Stable 81-character text form: rows concatenated, '1'-'9' for givens and '.' for
+// empty cells. decodeText also accepts '0' for empty cells.
+std::string encodeText(const int grid[9][9]);
+bool decodeText(const std::string& text, int grid[9][9]);
+
+#endif // BOARDCODEC_H
@@ -0,0 +1,158 @@
+#include "CandidateKernel.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CANDIDATE_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+static const unsigned short ALL_VALUES = 0x1FF;
+
+typedef void (*KernelFunction)(const int*, const unsigned short*, const unsigned short*,
+                               const unsigned short*, unsigned short*);
+
+// Reference implementation, also used for column 8 by the vector paths
+static inline unsigned short cellCandidates(const int cells[81], const unsigned short rowUsed[9],
+                                            const unsigned short colUsed[9], const unsigned short boxUsed[9],
+                                            int row, int col) {
+    if (cells[row * 9 + col] != 0) {
+        return 0;
+    }
+    unsigned int used = rowUsed[row] | colUsed[col] | boxUsed[(row / 3) * 3 + col / 3];
+    return static_cast<unsigned short>(ALL_VALUES & ~used);
+}
+
+static void computeScalar(const int cells[81], const unsigned short rowUsed[9], const unsigned short colUsed[9],
+                          const unsigned short boxUsed[9], unsigned short candidates[81]) {
+    for (int row = 0; row < 9; row++) {
+        for (int col = 0; col < 9; col++) {
+            candidates[row * 9 + col] = cellCandidates(cells, rowUsed, colUsed, boxUsed, row, col);
+        }
+    }
+}
+
+#ifdef CANDIDATE_KERNEL_X86
+
+// Columns 0..7 of one row in 16-bit lanes: ~(row | col | box) & ALL, zeroed for filled cells
+__attribute__((target("sse4.2")))
+static void computeSSE42(const int cells[81], const unsigned short rowUsed[9], const unsigned short colUsed[9],
+                         const unsigned short boxUsed[9], unsigned short candidates[81]) {
+    const __m128i all = _mm_set1_epi16(ALL_VALUES);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i cols = _mm_setr_epi16(
+        static_cast<short>(colUsed[0]), static_cast<short>(colUsed[1]), static_cast<short>(colUsed[2]),
+        static_cast<short>(colUsed[3]), static_cast<short>(colUsed[4]), static_cast<short>(colUsed[5]),
+        static_cast<short>(colUsed[6]), static_cast<short>(colUsed[7]));
+
+    for (int band = 0; band < 3; band++) {
+        short b0 = static_cast<short>(boxUsed[band * 3]);
+        short b1 = static_cast<short>(boxUsed[band * 3 + 1]);
+        short b2 = static_cast<short>(boxUsed[band * 3 + 2]);
+        const __m128i boxes = _mm_or_si128(cols, _mm_setr_epi16(b0, b0, b0, b1, b1, b1, b2, b2));
+
+        for (int row = band * 3; row < band * 3 + 3; row++) {
+            const int* rowCells = cells + row * 9;
+            __m128i used = _mm_or_si128(boxes, _mm_set1_epi16(static_cast<short>(rowUsed[row])));
+            __m128i mask = _mm_andnot_si128(used, all);
+
+            // Lanes of empty cells are all ones after the compare
+            __m128i lo = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rowCells)), zero);
+            __m128i hi = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rowCells + 4)), zero);
+            mask = _mm_and_si128(mask, _mm_packs_epi32(lo, hi));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(candidates + row * 9), mask);
+            candidates[row * 9 + 8] = cellCandidates(cells, rowUsed, colUsed, boxUsed, row, 8);
+        }
+    }
+}
+
+// Two rows per iteration: columns 0..7 of row r in the low half, of row r+1 in the high half
+__attribute__((target("avx2")))
+static void computeAVX2(const int cells[81], const unsigned short rowUsed[9], const unsigned short colUsed[9],
+                        const unsigned short boxUsed[9], unsigned short candidates[81]) {
+    const __m256i all = _mm256_set1_epi16(ALL_VALUES);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m128i cols = _mm_setr_epi16(
+        static_cast<short>(colUsed[0]), static_cast<short>(colUsed[1]), static_cast<short>(colUsed[2]),
+        static_cast<short>(colUsed[3]), static_cast<short>(colUsed[4]), static_cast<short>(colUsed[5]),
+        static_cast<short>(colUsed[6]), static_cast<short>(colUsed[7]));
+
+    // Box masks of columns 0..7 for each band, combined with the column masks
+    __m256i bands[3];
+    for (int band = 0; band < 3; band++) {
+        short b0 = static_cast<short>(boxUsed[band * 3]);
+        short b1 = static_cast<short>(boxUsed[band * 3 + 1]);
+        short b2 = static_cast<short>(boxUsed[band * 3 + 2]);
+        __m128i boxes = _mm_or_si128(cols, _mm_setr_epi16(b0, b0, b0, b1, b1, b1, b2, b2));
+        bands[band] = _mm256_broadcastsi128_si256(boxes);
+    }
+
+    int row = 0;
+    for (; row < 8; row += 2) {
+        // Rows r and r+1 may straddle two bands
+        __m256i boxes = _mm256_blend_epi32(bands[row / 3], bands[(row + 1) / 3], 0xF0);
+        __m256i rows = _mm256_setr_m128i(_mm_set1_epi16(static_cast<short>(rowUsed[row])),
+                                         _mm_set1_epi16(static_cast<short>(rowUsed[row + 1])));
+        __m256i mask = _mm256_andnot_si256(_mm256_or_si256(boxes, rows), all);
+
+        __m256i first = _mm256_cmpeq_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells + row * 9)), zero);
+        __m256i second = _mm256_cmpeq_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells + (row + 1) * 9)), zero);
+        // packs works per 128-bit lane; restore row order afterwards
+        __m256i empties = _mm256_permute4x64_epi64(_mm256_packs_epi32(first, second), 0xD8);
+        mask = _mm256_and_si256(mask, empties);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(candidates + row * 9), _mm256_castsi256_si128(mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(candidates + (row + 1) * 9), _mm256_extracti128_si256(mask, 1));
+        candidates[row * 9 + 8] = cellCandidates(cells, rowUsed, colUsed, boxUsed, row, 8);
+        candidates[(row + 1) * 9 + 8] = cellCandidates(cells, rowUsed, colUsed, boxUsed, row + 1, 8);
+    }
+
+    // Last (odd) row in one 128-bit half
+    const int* rowCells = cells + row * 9;
+    __m128i used = _mm_or_si128(_mm256_castsi256_si128(bands[row / 3]),
+                                _mm_set1_epi16(static_cast<short>(rowUsed[row])));
+    __m128i mask = _mm_andnot_si128(used, _mm256_castsi256_si128(all));
+    __m128i lo = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rowCells)), _mm_setzero_si128());
+    __m128i hi = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rowCells + 4)), _mm_setzero_si128());
+    mask = _mm_and_si128(mask, _mm_packs_epi32(lo, hi));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(candidates + row * 9), mask);
+    candidates[row * 9 + 8] = cellCandidates(cells, rowUsed, colUsed, boxUsed, row, 8);
+}
+
+#endif // CANDIDATE_KERNEL_X86
+
+struct KernelChoice {
+    KernelFunction function;
+    const char* name;
+};
+
+static KernelChoice chooseKernel() {
+#ifdef CANDIDATE_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return KernelChoice{computeAVX2, "avx2"};
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return KernelChoice{computeSSE42, "sse4.2"};
+    }
+#endif
+    return KernelChoice{computeScalar, "scalar"};
+}
+
+static const KernelChoice& selectedKernel() {
+    static const KernelChoice choice = chooseKernel();
+    return choice;
+}
+
+void computeCandidates(const int cells[81],
+                       const unsigned short rowUsed[9],
+                       const unsigned short colUsed[9],
+                       const unsigned short boxUsed[9],
+                       unsigned short candidates[81]) {
+    selectedKernel().function(cells, rowUsed, colUsed, boxUsed, candidates);
+}
+
+const char* candidateKernelName() {
+    return selectedKernel().name;
+}
@@ -0,0 +1,19 @@
+#ifndef CANDIDATEKERNEL_H
+#define CANDIDATEKERNEL_H
+
+// Whole-board candidate computation for 9x9 Sudoku.
+//
+// Computes the candidate mask (bit v-1 for value v) of all 81 cells in one pass from
+// the per-row, column and box masks of used digits. Filled cells get an empty mask.
+// On x86 the widest available of AVX2 / SSE4.2 is picked at runtime; every other
+// target uses the scalar loop.
+void computeCandidates(const int cells[81],
+                       const unsigned short rowUsed[9],
+                       const unsigned short colUsed[9],
+                       const unsigned short boxUsed[9],
+                       unsigned short candidates[81]);
+
+// Name of the implementation computeCandidates dispatches to ("avx2", "sse4.2" or "scalar")
+const char* candidateKernelName();
+
+#endif // CANDIDATEKERNEL_H
@@ -0,0 +1,264 @@
+#include "DancingLinks.h"
+
+template <int BoxSize>
+BasicDancingLinks<BoxSize>::BasicDancingLinks() : nodes(NUM_NODES), givensValid(true), dirty(true), found(0), stats(nullptr) {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            givens[row][col] = 0;
+        }
+    }
+}
+
+// Load the givens of a puzzle
+template <int BoxSize>
+bool BasicDancingLinks<BoxSize>::load(const int grid[SIZE][SIZE]) {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            int val = grid[row][col];
+            givens[row][col] = (val >= 1 && val <= SIZE) ? val : 0;
+        }
+    }
+
+    givensValid = reset();
+    dirty = !givensValid;
+    return givensValid;
+}
+
+// Rebuild the full matrix in the arena and cover the columns of every given
+template <int BoxSize>
+bool BasicDancingLinks<BoxSize>::reset() {
+    // Root and column headers form one circular list
+    for (int h = 0; h <= NUM_COLUMNS; h++) {
+        nodes[h].left = (h == 0) ? NUM_COLUMNS : h - 1;
+        nodes[h].right = (h == NUM_COLUMNS) ? 0 : h + 1;
+        nodes[h].up = h;
+        nodes[h].down = h;
+        nodes[h].column = h;
+        nodes[h].row = -1;
+        columnSize[h] = 0;
+    }
+
+    // One row of four nodes per (cell, digit) placement
+    for (int r = 0; r < NUM_ROWS; r++) {
+        int cell = r / SIZE;
+        int digit = r % SIZE;
+        int row = cell / SIZE;
+        int col = cell % SIZE;
+        int box = (row / BoxSize) * BoxSize + col / BoxSize;
+
+        int columns[4] = {
+            cell,
+            CELLS + row * SIZE + digit,
+            2 * CELLS + col * SIZE + digit,
+            3 * CELLS + box * SIZE + digit
+        };
+
+        int base = 1 + NUM_COLUMNS + r * 4;
+        for (int k = 0; k < 4; k++) {
+            int n = base + k;
+            int header = columns[k] + 1;
+
+            // Append at the bottom of the column
+            nodes[n].column = header;
+            nodes[n].row = r;
+            nodes[n].up = nodes[header].up;
+            nodes[n].down = header;
+            nodes[nodes[header].up].down = n;
+            nodes[header].up = n;
+            columnSize[header]++;
+
+            nodes[n].left = base + (k + 3) % 4;
+            nodes[n].right = base + (k + 1) % 4;
+        }
+    }
+
+    // Select the rows of the givens
+    bool covered[NUM_COLUMNS + 1] = {false};
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            int val = givens[row][col];
+            if (val == 0) {
+                continue;
+            }
+
+            int base = 1 + NUM_COLUMNS + ((row * SIZE + col) * SIZE + val - 1) * 4;
+            for (int k = 0; k < 4; k++) {
+                int header = nodes[base + k].column;
+                if (covered[header]) {
+                    return false; // Two givens claim the same constraint
+                }
+                covered[header] = true;
+                cover(header);
+            }
+        }
+    }
+
+    return true;
+}
+
+// Remove a column and every row that intersects it
+template <int BoxSize>
+void BasicDancingLinks<BoxSize>::cover(int column) {
+    nodes[nodes[column].right].left = nodes[column].left;
+    nodes[nodes[column].left].right = nodes[column].right;
+
+    for (int i = nodes[column].down; i != column; i = nodes[i].down) {
+        for (int j = nodes[i].right; j != i; j = nodes[j].right) {
+            nodes[nodes[j].down].up = nodes[j].up;
+            nodes[nodes[j].up].down = nodes[j].down;
+            columnSize[nodes[j].column]--;
+        }
+    }
+}
+
+// Undo cover() in exactly the reverse order
+template <int BoxSize>
+void BasicDancingLinks<BoxSize>::uncover(int column) {
+    for (int i = nodes[column].up; i != column; i = nodes[i].up) {
+        for (int j = nodes[i].left; j != i; j = nodes[j].left) {
+            columnSize[nodes[j].column]++;
+            nodes[nodes[j].down].up = j;
+            nodes[nodes[j].up].down = j;
+        }
+    }
+
+    nodes[nodes[column].right].left = column;
+    nodes[nodes[column].left].right = column;
+}
+
+// Algorithm X; returns true once limit solutions have been found (or the visitor stops)
+template <int BoxSize>
+bool BasicDancingLinks<BoxSize>::search(int depth, int limit, const SolutionVisitor* visitor) {
+    SOLVER_STAT(
+        if (stats != nullptr) {
+            stats->nodesVisited++;
+            if (depth > stats->maxDepth) {
+                stats->maxDepth = depth;
+            }
+        }
+    )
+
+    if (nodes[ROOT].right == ROOT) {
+        found++;
+        if (visitor != nullptr) {
+            int solution[SIZE][SIZE];
+            writeSolution(depth, solution);
+            if (!(*visitor)(solution)) {
+                return true;
+            }
+        }
+        return found >= limit;
+    }
+
+    // Branch on the column with the fewest remaining rows
+    int column = nodes[ROOT].right;
+    for (int h = nodes[column].right; h != ROOT; h = nodes[h].right) {
+        if (columnSize[h] < columnSize[column]) {
+            column = h;
+        }
+    }
+    if (columnSize[column] == 0) {
+        return false; // Dead end
+    }
+
+    cover(column);
+    for (int r = nodes[column].down; r != column; r = nodes[r].down) {
+        solutionRows[depth] = nodes[r].row;
+        for (int j = nodes[r].right; j != r; j = nodes[j].right) {
+            cover(nodes[j].column);
+        }
+        SOLVER_STAT(
+            if (stats != nullptr) {
+                stats->candidateEvaluations++;
+                stats->propagations++;
+            }
+        )
+
+        if (search(depth + 1, limit, visitor)) {
+            return true; // Links stay covered; runSearch() marks the matrix dirty
+        }
+        SOLVER_STAT(
+            if (stats != nullptr) {
+                stats->backtracks++;
+            }
+        )
+
+        for (int j = nodes[r].left; j != r; j = nodes[j].left) {
+            uncover(nodes[j].column);
+        }
+    }
+    uncover(column);
+
+    return false;
+}
+
+// Combine the givens with the rows chosen so far
+template <int BoxSize>
+void BasicDancingLinks<BoxSize>::writeSolution(int depth, int solution[SIZE][SIZE]) const {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            solution[row][col] = givens[row][col];
+        }
+    }
+
+    for (int i = 0; i < depth; i++) {
+        int cell = solutionRows[i] / SIZE;
+        solution[cell / SIZE][cell % SIZE] = solutionRows[i] % SIZE + 1;
+    }
+}
+
+// Solve the loaded puzzle
+template <int BoxSize>
+bool BasicDancingLinks<BoxSize>::solve(int solution[SIZE][SIZE]) {
+    bool solved = false;
+    SolutionVisitor visitor = [&solution, &solved](const int (&grid)[SIZE][SIZE]) {
+        for (int row = 0; row < SIZE; row++) {
+            for (int col = 0; col < SIZE; col++) {
+                solution[row][col] = grid[row][col];
+            }
+        }
+        solved = true;
+        return false;
+    };
+
+    enumerateSolutions(1, visitor);
+    return solved;
+}
+
+// Count solutions, stopping as soon as limit is reached
+template <int BoxSize>
+int BasicDancingLinks<BoxSize>::countSolutions(int limit) {
+    return runSearch(limit, nullptr);
+}
+
+// Search the loaded puzzle. A search that runs to the end uncovers everything it
+// covered, so the matrix is only rebuilt after one that stopped early.
+template <int BoxSize>
+int BasicDancingLinks<BoxSize>::runSearch(int limit, const SolutionVisitor* visitor) {
+    if (limit <= 0 || !givensValid) {
+        return 0;
+    }
+    if (dirty) {
+        reset();
+    }
+
+    found = 0;
+    dirty = search(0, limit, visitor);
+    return found;
+}
+
+template <int BoxSize>
+void BasicDancingLinks<BoxSize>::setStats(SolverStats* counters) {
+    stats = counters;
+}
+
+// Call visitor for each solution, up to limit
+template <int BoxSize>
+int BasicDancingLinks<BoxSize>::enumerateSolutions(int limit, const SolutionVisitor& visitor) {
+    return runSearch(limit, &visitor);
+}
+
+// 9x9, 16x16 and 25x25
+template class BasicDancingLinks<3>;
+template class BasicDancingLinks<4>;
+template class BasicDancingLinks<5>;
@@ -0,0 +1,75 @@
+#ifndef DANCINGLINKS_H
+#define DANCINGLINKS_H
+
+#include "SolverStats.h"
+#include <vector>
+#include <functional>
+
+// Exact-cover (Algorithm X) solver for Sudoku with BoxSize x BoxSize boxes using
+// dancing links.
+//
+// Columns (4 * CELLS): the cell constraints, then row-digit, column-digit and
+// box-digit constraints (CELLS each). Rows (CELLS * SIZE): one per (cell, digit)
+// placement, each covering exactly four columns; 324 columns and 729 rows for 9x9.
+// All nodes live in one preallocated arena and are linked by index, so solving never
+// allocates.
+template <int BoxSize>
+class BasicDancingLinks {
+public:
+    static const int SIZE = BoxSize * BoxSize;
+    static const int CELLS = SIZE * SIZE;
+    static const int NUM_COLUMNS = 4 * CELLS;
+    static const int NUM_ROWS = CELLS * SIZE;
+
+    // Called with each solution found; return false to stop the enumeration
+    typedef std::function<bool(const int (&)[SIZE][SIZE])> SolutionVisitor;
+
+    BasicDancingLinks();
+
+    // Load the givens of a puzzle (0 = empty); returns false if they conflict
+    bool load(const int grid[SIZE][SIZE]);
+
+    // Solve the loaded puzzle, writing the first solution found
+    bool solve(int solution[SIZE][SIZE]);
+
+    // Count solutions, stopping as soon as limit is reached
+    int countSolutions(int limit);
+
+    // Call visitor for each solution (up to limit); returns the number visited
+    int enumerateSolutions(int limit, const SolutionVisitor& visitor);
+
+    // Add search counters to stats (nullptr to stop counting)
+    void setStats(SolverStats* counters);
+
+private:
+    struct Node {
+        int left, right, up, down;
+        int column;  // Header node of this node's column
+        int row;     // Placement index (cell * SIZE + digit - 1), -1 for headers
+    };
+
+    static const int ROOT = 0;
+    static const int NUM_NODES = 1 + NUM_COLUMNS + NUM_ROWS * 4;
+
+    std::vector<Node> nodes;  // Arena: root, column headers, then 4 nodes per row
+    int columnSize[NUM_COLUMNS + 1];
+    int givens[SIZE][SIZE];
+    bool givensValid;
+    bool dirty;  // A search stopped early and left columns covered
+    int solutionRows[CELLS];
+    int found;
+    SolverStats* stats;
+
+    // Rebuild the full matrix and cover the givens
+    bool reset();
+    void cover(int column);
+    void uncover(int column);
+    bool search(int depth, int limit, const SolutionVisitor* visitor);
+    int runSearch(int limit, const SolutionVisitor* visitor);
+    void writeSolution(int depth, int solution[SIZE][SIZE]) const;
+};
+
+// Classic 9x9 solver
+typedef BasicDancingLinks<3> DancingLinks;
+
+#endif // DANCINGLINKS_H
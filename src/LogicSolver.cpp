@@ -0,0 +1,499 @@
+#include "LogicSolver.h"
+#include "data-structures/bitmask.h"
+#include "data-structures/peerTable.h"
+
+static const unsigned int ALL_VALUES = 0x1FF;
+
+// Cell indices of every unit (rows 0-8, columns 9-17, boxes 18-26), read off the
+// compile-time peer table: a unit is its first cell plus that cell's peers on the same
+// row, column or box, which the table already lists in ascending order
+struct LogicUnits {
+    int cells[27][9];
+};
+
+static constexpr LogicUnits buildUnits() {
+    typedef BoardGeometry<3> Geometry;
+    LogicUnits units{};
+    for (int i = 0; i < 9; i++) {
+        int rowStart = i * 9;
+        int colStart = i;
+        int boxStart = (i / 3) * 27 + (i % 3) * 3;
+        int rowCount = 0;
+        int colCount = 0;
+        int boxCount = 0;
+        units.cells[i][rowCount++] = rowStart;
+        units.cells[9 + i][colCount++] = colStart;
+        units.cells[18 + i][boxCount++] = boxStart;
+        for (int peer : peersOf<3>(rowStart)) {
+            if (peer / 9 == i) {
+                units.cells[i][rowCount++] = peer;
+            }
+        }
+        for (int peer : peersOf<3>(colStart)) {
+            if (peer % 9 == i) {
+                units.cells[9 + i][colCount++] = peer;
+            }
+        }
+        for (int peer : peersOf<3>(boxStart)) {
+            if (Geometry::boxIndex(peer / 9, peer % 9) == i) {
+                units.cells[18 + i][boxCount++] = peer;
+            }
+        }
+    }
+    return units;
+}
+
+static constexpr LogicUnits UNITS = buildUnits();
+
+static_assert(UNITS.cells[0][8] == 8 && UNITS.cells[17][8] == 80 && UNITS.cells[26][0] == 60 &&
+              UNITS.cells[26][8] == 80, "unit layout");
+
+LogicSolver::LogicSolver() : emptyCount(0), broken(false) {
+    for (int cell = 0; cell < 81; cell++) {
+        cells[cell] = 0;
+        candidates[cell] = 0;
+    }
+}
+
+// Solve as far as possible by logic and grade the puzzle
+LogicSolver::Result LogicSolver::solve(const int grid[9][9]) {
+    Result result;
+    result.solved = false;
+    result.contradiction = false;
+    result.techniques = 0;
+    for (int i = 0; i < NUM_TECHNIQUES; i++) {
+        result.uses[i] = 0;
+    }
+
+    // Load the givens and build the candidate masks
+    unsigned int rowUsed[9] = {0};
+    unsigned int colUsed[9] = {0};
+    unsigned int boxUsed[9] = {0};
+    broken = false;
+    emptyCount = 0;
+
+    for (int cell = 0; cell < 81; cell++) {
+        int row = cell / 9;
+        int col = cell % 9;
+        int box = (row / 3) * 3 + col / 3;
+        int val = grid[row][col];
+        cells[cell] = (val >= 1 && val <= 9) ? val : 0;
+        if (cells[cell] == 0) {
+            emptyCount++;
+            continue;
+        }
+
+        unsigned int bit = maskBit(cells[cell]);
+        if ((rowUsed[row] | colUsed[col] | boxUsed[box]) & bit) {
+            broken = true; // Conflicting givens
+        }
+        rowUsed[row] |= bit;
+        colUsed[col] |= bit;
+        boxUsed[box] |= bit;
+    }
+
+    for (int cell = 0; cell < 81; cell++) {
+        int row = cell / 9;
+        int col = cell % 9;
+        if (cells[cell] != 0) {
+            candidates[cell] = 0;
+            continue;
+        }
+        candidates[cell] = ALL_VALUES & ~(rowUsed[row] | colUsed[col] | boxUsed[(row / 3) * 3 + col / 3]);
+        if (candidates[cell] == 0) {
+            broken = true;
+        }
+    }
+
+    // Always retry the easiest technique after any progress
+    while (emptyCount > 0 && !broken) {
+        Technique used;
+        if (applyNakedSingles()) {
+            used = NAKED_SINGLE;
+        } else if (applyHiddenSingles()) {
+            used = HIDDEN_SINGLE;
+        } else if (applyPointing()) {
+            used = POINTING;
+        } else if (applyClaiming()) {
+            used = CLAIMING;
+        } else if (applyNakedSubsets(2)) {
+            used = NAKED_PAIR;
+        } else if (applyHiddenSubsets(2)) {
+            used = HIDDEN_PAIR;
+        } else if (applyNakedSubsets(3)) {
+            used = NAKED_TRIPLE;
+        } else if (applyHiddenSubsets(3)) {
+            used = HIDDEN_TRIPLE;
+        } else if (applyFish(2)) {
+            used = X_WING;
+        } else if (applyFish(3)) {
+            used = SWORDFISH;
+        } else {
+            break; // Stuck
+        }
+
+        result.techniques |= used;
+        result.uses[lowestValue(used) - 1]++;
+    }
+
+    result.contradiction = broken;
+    result.solved = !broken && emptyCount == 0;
+    result.rating = rate(result.techniques, result.solved);
+    for (int cell = 0; cell < 81; cell++) {
+        result.grid[cell / 9][cell % 9] = cells[cell];
+    }
+
+    return result;
+}
+
+// Rating for a set of techniques used
+LogicSolver::Rating LogicSolver::rate(unsigned int techniques, bool solved) {
+    if (!solved) {
+        return RATING_EXPERT;
+    }
+    if (techniques & ~(NAKED_SINGLE | HIDDEN_SINGLE | POINTING | CLAIMING)) {
+        return RATING_HARD;
+    }
+    if (techniques & (POINTING | CLAIMING)) {
+        return RATING_MEDIUM;
+    }
+    return RATING_EASY;
+}
+
+// Display name of a technique
+const char* LogicSolver::techniqueName(Technique technique) {
+    switch (technique) {
+        case NAKED_SINGLE: return "Naked Single";
+        case HIDDEN_SINGLE: return "Hidden Single";
+        case POINTING: return "Pointing";
+        case CLAIMING: return "Claiming";
+        case NAKED_PAIR: return "Naked Pair";
+        case HIDDEN_PAIR: return "Hidden Pair";
+        case NAKED_TRIPLE: return "Naked Triple";
+        case HIDDEN_TRIPLE: return "Hidden Triple";
+        case X_WING: return "X-Wing";
+        case SWORDFISH: return "Swordfish";
+    }
+    return "Unknown";
+}
+
+// Fill a cell and remove its value from the peers' candidates
+void LogicSolver::place(int cell, int val) {
+    unsigned int bit = maskBit(val);
+    cells[cell] = val;
+    candidates[cell] = 0;
+    emptyCount--;
+
+    for (int peer : peersOf<3>(cell)) {
+        if (cells[peer] == 0 && (candidates[peer] & bit)) {
+            candidates[peer] &= ~bit;
+            if (candidates[peer] == 0) {
+                broken = true;
+            }
+        }
+    }
+}
+
+// Remove candidates from an empty cell; returns true if anything changed
+bool LogicSolver::eliminate(int cell, unsigned int mask) {
+    if (cells[cell] != 0 || !(candidates[cell] & mask)) {
+        return false;
+    }
+
+    candidates[cell] &= ~mask;
+    if (candidates[cell] == 0) {
+        broken = true;
+    }
+    return true;
+}
+
+// A cell with one candidate takes that value
+bool LogicSolver::applyNakedSingles() {
+    bool progress = false;
+    for (int cell = 0; cell < 81 && !broken; cell++) {
+        if (cells[cell] == 0 && countBits(candidates[cell]) == 1) {
+            place(cell, lowestValue(candidates[cell]));
+            progress = true;
+        }
+    }
+    return progress;
+}
+
+// A value with one possible cell in a unit goes there
+bool LogicSolver::applyHiddenSingles() {
+    bool progress = false;
+
+    for (int u = 0; u < 27 && !broken; u++) {
+        for (int val = 1; val <= 9; val++) {
+            unsigned int bit = maskBit(val);
+            int found = -1;
+            int count = 0;
+            bool placed = false;
+            for (int i = 0; i < 9; i++) {
+                int cell = UNITS.cells[u][i];
+                if (candidates[cell] & bit) {
+                    found = cell;
+                    count++;
+                } else if (cells[cell] == val) {
+                    placed = true;
+                }
+            }
+            if (count == 0 && !placed) {
+                broken = true; // Nowhere left for the value in this unit
+                break;
+            }
+            if (count == 1) {
+                place(found, val);
+                progress = true;
+            }
+        }
+    }
+    return progress;
+}
+
+// size cells of a unit sharing exactly size candidates remove them from the rest of the unit
+bool LogicSolver::applyNakedSubsets(int size) {
+    bool progress = false;
+
+    for (int u = 0; u < 27; u++) {
+        // Empty cells small enough to be part of a subset
+        int members[9];
+        int count = 0;
+        for (int i = 0; i < 9; i++) {
+            int bits = countBits(candidates[UNITS.cells[u][i]]);
+            if (bits >= 2 && bits <= size) {
+                members[count++] = i;
+            }
+        }
+
+        // Every combination of size members
+        for (unsigned int chosen = 0; chosen < (1u << count); chosen++) {
+            if (countBits(chosen) != size) {
+                continue;
+            }
+
+            unsigned int combined = 0;
+            unsigned int inSubset = 0;
+            for (int k = 0; k < count; k++) {
+                if (chosen & (1u << k)) {
+                    combined |= candidates[UNITS.cells[u][members[k]]];
+                    inSubset |= 1u << members[k];
+                }
+            }
+            if (countBits(combined) != size) {
+                continue;
+            }
+
+            for (int i = 0; i < 9; i++) {
+                if (!(inSubset & (1u << i)) && eliminate(UNITS.cells[u][i], combined)) {
+                    progress = true;
+                }
+            }
+        }
+    }
+    return progress;
+}
+
+// size values confined to the same size cells of a unit clear every other candidate from those cells
+bool LogicSolver::applyHiddenSubsets(int size) {
+    bool progress = false;
+
+    for (int u = 0; u < 27; u++) {
+        // Positions (unit indices) of each value
+        unsigned int positions[10];
+        int values[9];
+        int count = 0;
+        for (int val = 1; val <= 9; val++) {
+            positions[val] = 0;
+            for (int i = 0; i < 9; i++) {
+                if (candidates[UNITS.cells[u][i]] & maskBit(val)) {
+                    positions[val] |= 1u << i;
+                }
+            }
+            int bits = countBits(positions[val]);
+            if (bits >= 2 && bits <= size) {
+                values[count++] = val;
+            }
+        }
+
+        // Every combination of size values
+        for (unsigned int chosen = 0; chosen < (1u << count); chosen++) {
+            if (countBits(chosen) != size) {
+                continue;
+            }
+
+            unsigned int where = 0;
+            unsigned int keep = 0;
+            for (int k = 0; k < count; k++) {
+                if (chosen & (1u << k)) {
+                    where |= positions[values[k]];
+                    keep |= maskBit(values[k]);
+                }
+            }
+            if (countBits(where) != size) {
+                continue;
+            }
+
+            for (int i = 0; i < 9; i++) {
+                if ((where & (1u << i)) && eliminate(UNITS.cells[u][i], ALL_VALUES & ~keep)) {
+                    progress = true;
+                }
+            }
+        }
+    }
+    return progress;
+}
+
+// A value confined to one row or column of a box is removed from the rest of that line
+bool LogicSolver::applyPointing() {
+    bool progress = false;
+
+    for (int box = 0; box < 9; box++) {
+        int startRow = (box / 3) * 3;
+        int startCol = (box % 3) * 3;
+        for (int val = 1; val <= 9; val++) {
+            unsigned int bit = maskBit(val);
+            unsigned int rows = 0;
+            unsigned int cols = 0;
+            for (int r = startRow; r < startRow + 3; r++) {
+                for (int c = startCol; c < startCol + 3; c++) {
+                    if (candidates[r * 9 + c] & bit) {
+                        rows |= 1u << r;
+                        cols |= 1u << c;
+                    }
+                }
+            }
+            if (rows == 0) {
+                continue;
+            }
+
+            if (countBits(rows) == 1) {
+                int row = lowestValue(rows) - 1;
+                for (int c = 0; c < 9; c++) {
+                    if ((c < startCol || c >= startCol + 3) && eliminate(row * 9 + c, bit)) {
+                        progress = true;
+                    }
+                }
+            }
+            if (countBits(cols) == 1) {
+                int col = lowestValue(cols) - 1;
+                for (int r = 0; r < 9; r++) {
+                    if ((r < startRow || r >= startRow + 3) && eliminate(r * 9 + col, bit)) {
+                        progress = true;
+                    }
+                }
+            }
+        }
+    }
+    return progress;
+}
+
+// A value confined to one box within a row or column is removed from the rest of that box
+bool LogicSolver::applyClaiming() {
+    bool progress = false;
+
+    for (int line = 0; line < 9; line++) {
+        for (int val = 1; val <= 9; val++) {
+            unsigned int bit = maskBit(val);
+            unsigned int rowBoxes = 0; // Box columns (0-2) holding the value in row `line`
+            unsigned int colBoxes = 0; // Box rows (0-2) holding the value in column `line`
+            for (int i = 0; i < 9; i++) {
+                if (candidates[line * 9 + i] & bit) {
+                    rowBoxes |= 1u << (i / 3);
+                }
+                if (candidates[i * 9 + line] & bit) {
+                    colBoxes |= 1u << (i / 3);
+                }
+            }
+
+            if (countBits(rowBoxes) == 1) {
+                int startRow = (line / 3) * 3;
+                int startCol = (lowestValue(rowBoxes) - 1) * 3;
+                for (int r = startRow; r < startRow + 3; r++) {
+                    for (int c = startCol; c < startCol + 3; c++) {
+                        if (r != line && eliminate(r * 9 + c, bit)) {
+                            progress = true;
+                        }
+                    }
+                }
+            }
+            if (countBits(colBoxes) == 1) {
+                int startRow = (lowestValue(colBoxes) - 1) * 3;
+                int startCol = (line / 3) * 3;
+                for (int r = startRow; r < startRow + 3; r++) {
+                    for (int c = startCol; c < startCol + 3; c++) {
+                        if (c != line && eliminate(r * 9 + c, bit)) {
+                            progress = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return progress;
+}
+
+// X-Wing (size 2) and Swordfish (size 3): a value confined to the same size columns in
+// size rows is removed from those columns in every other row, and the same with rows
+// and columns swapped
+bool LogicSolver::applyFish(int size) {
+    bool progress = false;
+
+    for (int val = 1; val <= 9; val++) {
+        unsigned int bit = maskBit(val);
+        for (int orientation = 0; orientation < 2; orientation++) {
+            // Cover lines each base line's candidates sit on
+            unsigned int cover[9];
+            int bases[9];
+            int count = 0;
+            for (int base = 0; base < 9; base++) {
+                cover[base] = 0;
+                for (int i = 0; i < 9; i++) {
+                    int cell = (orientation == 0) ? base * 9 + i : i * 9 + base;
+                    if (candidates[cell] & bit) {
+                        cover[base] |= 1u << i;
+                    }
+                }
+                int bits = countBits(cover[base]);
+                if (bits >= 2 && bits <= size) {
+                    bases[count++] = base;
+                }
+            }
+
+            // Every combination of size base lines
+            for (unsigned int chosen = 0; chosen < (1u << count); chosen++) {
+                if (countBits(chosen) != size) {
+                    continue;
+                }
+
+                unsigned int lines = 0;
+                unsigned int baseSet = 0;
+                for (int k = 0; k < count; k++) {
+                    if (chosen & (1u << k)) {
+                        lines |= cover[bases[k]];
+                        baseSet |= 1u << bases[k];
+                    }
+                }
+                if (countBits(lines) != size) {
+                    continue;
+                }
+
+                for (int other = 0; other < 9; other++) {
+                    if (baseSet & (1u << other)) {
+                        continue;
+                    }
+                    for (int i = 0; i < 9; i++) {
+                        if (!(lines & (1u << i))) {
+                            continue;
+                        }
+                        int cell = (orientation == 0) ? other * 9 + i : i * 9 + other;
+                        if (eliminate(cell, bit)) {
+                            progress = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return progress;
+}
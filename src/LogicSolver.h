@@ -0,0 +1,73 @@
+#ifndef LOGICSOLVER_H
+#define LOGICSOLVER_H
+
+// Human-style Sudoku solver used to grade puzzles.
+//
+// Applies techniques from easiest to hardest, restarting from the easiest after every
+// step that makes progress, until the grid is solved or nothing applies. The set of
+// techniques that were needed gives the puzzle's rating. Works entirely on a flat copy
+// of the grid and candidate bitmasks, so grading never allocates.
+class LogicSolver {
+public:
+    // Techniques in the order they are tried
+    enum Technique {
+        NAKED_SINGLE  = 1 << 0,
+        HIDDEN_SINGLE = 1 << 1,
+        POINTING      = 1 << 2,  // Box candidates confined to one row/column
+        CLAIMING      = 1 << 3,  // Row/column candidates confined to one box
+        NAKED_PAIR    = 1 << 4,
+        HIDDEN_PAIR   = 1 << 5,
+        NAKED_TRIPLE  = 1 << 6,
+        HIDDEN_TRIPLE = 1 << 7,
+        X_WING        = 1 << 8,
+        SWORDFISH     = 1 << 9
+    };
+    static const int NUM_TECHNIQUES = 10;
+
+    // Ratings derived from the hardest technique needed
+    enum Rating {
+        RATING_EASY = 1,    // Singles only
+        RATING_MEDIUM = 2,  // Pointing and claiming
+        RATING_HARD = 3,    // Pairs, triples, X-Wing or Swordfish
+        RATING_EXPERT = 4   // Logic alone gets stuck; guessing required
+    };
+
+    struct Result {
+        bool solved;                 // Every cell was filled by logic
+        bool contradiction;          // A cell or a unit ran out of candidates (invalid puzzle)
+        unsigned int techniques;     // Bitwise OR of the techniques used
+        int uses[NUM_TECHNIQUES];    // How many times each technique made progress
+        Rating rating;
+        int grid[9][9];              // Grid as far as logic got (0 = still empty)
+    };
+
+    LogicSolver();
+
+    // Solve as far as possible by logic and grade the puzzle
+    Result solve(const int grid[9][9]);
+
+    // Rating for a set of techniques used
+    static Rating rate(unsigned int techniques, bool solved);
+
+    // Display name of a technique
+    static const char* techniqueName(Technique technique);
+
+private:
+    int cells[81];               // Current values (0 = empty)
+    unsigned int candidates[81]; // Candidate masks of empty cells (0 for filled)
+    int emptyCount;
+    bool broken;                 // An empty cell lost every candidate, or a value has no cell left in a unit
+
+    void place(int cell, int val);
+    bool eliminate(int cell, unsigned int mask);
+
+    bool applyNakedSingles();
+    bool applyHiddenSingles();
+    bool applyNakedSubsets(int size);
+    bool applyHiddenSubsets(int size);
+    bool applyPointing();
+    bool applyClaiming();
+    bool applyFish(int size);
+};
+
+#endif // LOGICSOLVER_H
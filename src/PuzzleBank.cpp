@@ -0,0 +1,185 @@
+#include "PuzzleBank.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char BANK_MAGIC[8] = { 'S', 'D', 'K', 'B', 'A', 'N', 'K', '1' };
+
+static_assert(sizeof(PuzzleRecord) == 60, "PuzzleRecord layout is part of the file format");
+static_assert(sizeof(PuzzleBankHeader) == 52, "PuzzleBankHeader layout is part of the file format");
+
+PuzzleBank::PuzzleBank()
+    : data(nullptr), size(0), header(nullptr), records(nullptr), rng(std::random_device()())
+#ifdef _WIN32
+    , fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{
+}
+
+PuzzleBank::~PuzzleBank() {
+    close();
+}
+
+PuzzleBank& PuzzleBank::shared() {
+    static PuzzleBank bank;
+    return bank;
+}
+
+bool PuzzleBank::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping stays valid
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    size = static_cast<size_t>(info.st_size);
+#endif
+    data = static_cast<const unsigned char*>(view);
+
+    // Validate the header and index before trusting any offsets
+    header = reinterpret_cast<const PuzzleBankHeader*>(data);
+    bool valid = size >= sizeof(PuzzleBankHeader)
+              && std::memcmp(header->magic, BANK_MAGIC, sizeof(BANK_MAGIC)) == 0
+              && header->version == VERSION
+              && header->byteOrder == BYTE_ORDER_MARK
+              && header->recordSize == sizeof(PuzzleRecord)
+              && (size - sizeof(PuzzleBankHeader)) / sizeof(PuzzleRecord) >= header->recordCount;
+    for (int level = 0; valid && level < SudokuSolver::NUM_DIFFICULTIES; level++) {
+        valid = header->levelStart[level] <= header->recordCount
+             && header->levelCount[level] <= header->recordCount - header->levelStart[level];
+    }
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    records = reinterpret_cast<const PuzzleRecord*>(data + sizeof(PuzzleBankHeader));
+    return true;
+}
+
+void PuzzleBank::close() {
+    if (data != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<unsigned char*>(data), size);
+#endif
+    }
+    data = nullptr;
+    size = 0;
+    header = nullptr;
+    records = nullptr;
+}
+
+bool PuzzleBank::isOpen() const {
+    return records != nullptr;
+}
+
+int PuzzleBank::count(SudokuSolver::Difficulty difficulty) const {
+    if (!isOpen()) {
+        return 0;
+    }
+    return static_cast<int>(header->levelCount[SudokuSolver::difficultyIndex(difficulty)]);
+}
+
+const PuzzleRecord* PuzzleBank::record(SudokuSolver::Difficulty difficulty, int index) const {
+    if (index < 0 || index >= count(difficulty)) {
+        return nullptr;
+    }
+    return &records[header->levelStart[SudokuSolver::difficultyIndex(difficulty)] + index];
+}
+
+bool PuzzleBank::pickRandom(SudokuSolver::Difficulty difficulty, PuzzleGrid& puzzle) {
+    int available = count(difficulty);
+    if (available == 0) {
+        return false;
+    }
+
+    std::uniform_int_distribution<int> dist(0, available - 1);
+    const PuzzleRecord* picked = record(difficulty, dist(rng));
+    PackedBoardView view(picked->packed, sizeof(picked->packed));
+    if (!view.isValid()) {
+        return false;
+    }
+    view.unpackClues(puzzle.cells);
+    return true;
+}
+
+bool PuzzleBank::write(const std::string& path,
+                       const std::vector<PuzzleRecord> levels[SudokuSolver::NUM_DIFFICULTIES]) {
+    PuzzleBankHeader out;
+    std::memset(&out, 0, sizeof(out));
+    std::memcpy(out.magic, BANK_MAGIC, sizeof(BANK_MAGIC));
+    out.version = VERSION;
+    out.byteOrder = BYTE_ORDER_MARK;
+    out.recordSize = sizeof(PuzzleRecord);
+    for (int level = 0; level < SudokuSolver::NUM_DIFFICULTIES; level++) {
+        out.levelStart[level] = out.recordCount;
+        out.levelCount[level] = static_cast<uint32_t>(levels[level].size());
+        out.recordCount += out.levelCount[level];
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = std::fwrite(&out, sizeof(out), 1, file) == 1;
+    for (int level = 0; ok && level < SudokuSolver::NUM_DIFFICULTIES; level++) {
+        if (!levels[level].empty()) {
+            ok = std::fwrite(levels[level].data(), sizeof(PuzzleRecord), levels[level].size(), file)
+                 == levels[level].size();
+        }
+    }
+    if (std::fclose(file) != 0) {
+        ok = false;
+    }
+    return ok;
+}
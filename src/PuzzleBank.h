@@ -0,0 +1,83 @@
+#ifndef PUZZLEBANK_H
+#define PUZZLEBANK_H
+
+#include "PuzzlePool.h"
+#include "BoardCodec.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Binary puzzle bank file, memory-mapped and read in place without parsing.
+//
+// Layout: a PuzzleBankHeader followed by fixed-size PuzzleRecords sorted by difficulty,
+// so the records of one difficulty are the contiguous range given by the header's
+// index. Fields are in the byte order of the machine that wrote the file, so the records
+// can be used in place; the header's byteOrder mark lets a machine of the other byte
+// order reject the file instead of misreading it (rebuild the bank there).
+
+// One stored puzzle (60 bytes)
+struct PuzzleRecord {
+    uint8_t packed[PACKED_SOLVED_SIZE];  // Clues and unique solution (see BoardCodec.h)
+    uint8_t rating;                      // LogicSolver::Rating of the puzzle
+    uint8_t reserved[2];                 // Zero
+    uint32_t seed;                       // SudokuSolver::setSeed value that regenerates it
+};
+
+struct PuzzleBankHeader {
+    char magic[8];          // "SDKBANK1"
+    uint16_t version;
+    uint16_t byteOrder;     // BYTE_ORDER_MARK as written
+    uint32_t recordSize;    // sizeof(PuzzleRecord)
+    uint32_t recordCount;
+    uint32_t levelStart[SudokuSolver::NUM_DIFFICULTIES];  // First record of each difficulty
+    uint32_t levelCount[SudokuSolver::NUM_DIFFICULTIES];  // Records of each difficulty
+};
+
+class PuzzleBank {
+public:
+    static const uint16_t VERSION = 3;
+    static const uint16_t BYTE_ORDER_MARK = 0xFEFF;  // Reads as 0xFFFE in the other byte order
+
+    PuzzleBank();
+    ~PuzzleBank();
+
+    // Bank used by the game
+    static PuzzleBank& shared();
+
+    // Map a bank file read-only; returns false if it is missing or malformed
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    // Number of puzzles stored for a difficulty
+    int count(SudokuSolver::Difficulty difficulty) const;
+
+    // Record of a difficulty by index (nullptr if out of range)
+    const PuzzleRecord* record(SudokuSolver::Difficulty difficulty, int index) const;
+
+    // Copy a random puzzle of a difficulty; returns false if there is none
+    bool pickRandom(SudokuSolver::Difficulty difficulty, PuzzleGrid& puzzle);
+
+    // Write a bank file from records grouped by difficulty index
+    static bool write(const std::string& path,
+                      const std::vector<PuzzleRecord> levels[SudokuSolver::NUM_DIFFICULTIES]);
+
+private:
+    const unsigned char* data;  // Mapped file
+    size_t size;
+    const PuzzleBankHeader* header;
+    const PuzzleRecord* records;
+    std::mt19937 rng;
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+    // Disable copying
+    PuzzleBank(const PuzzleBank&);
+    PuzzleBank& operator=(const PuzzleBank&);
+};
+
+#endif // PUZZLEBANK_H
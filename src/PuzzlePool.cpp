@@ -0,0 +1,132 @@
+#include "PuzzlePool.h"
+#include <random>
+
+PuzzlePool::PuzzlePool(int depth) : targetDepth(depth), stopping(false) {
+    for (int level = 0; level < NUM_LEVELS; level++) {
+        pending[level] = 0;
+    }
+}
+
+PuzzlePool::~PuzzlePool() {
+    stop();
+}
+
+PuzzlePool& PuzzlePool::shared() {
+    static PuzzlePool pool;
+    return pool;
+}
+
+void PuzzlePool::start(int workerCount) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!workers.empty()) {
+        return;
+    }
+    stopping = false;
+
+    // Each worker gets its own seed so they don't generate the same puzzles
+    std::random_device seeder;
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&PuzzlePool::workerLoop, this, seeder());
+    }
+}
+
+void PuzzlePool::stop() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+void PuzzlePool::setDepth(int depth) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        targetDepth = depth;
+    }
+    wake.notify_all();
+}
+
+int PuzzlePool::getDepth() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return targetDepth;
+}
+
+bool PuzzlePool::tryPop(SudokuSolver::Difficulty difficulty, PuzzleGrid& puzzle) {
+    int level = SudokuSolver::difficultyIndex(difficulty);
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (ready[level].empty()) {
+            return false;
+        }
+        puzzle = ready[level].front();
+        ready[level].pop_front();
+    }
+
+    // Let a worker refill the slot
+    wake.notify_one();
+    return true;
+}
+
+int PuzzlePool::available(SudokuSolver::Difficulty difficulty) const {
+    std::lock_guard<std::mutex> guard(lock);
+    return static_cast<int>(ready[SudokuSolver::difficultyIndex(difficulty)].size());
+}
+
+int PuzzlePool::levelToFill() const {
+    int best = -1;
+    int bestCount = targetDepth;
+    for (int level = 0; level < NUM_LEVELS; level++) {
+        int count = static_cast<int>(ready[level].size()) + pending[level];
+        if (count < bestCount) {
+            best = level;
+            bestCount = count;
+        }
+    }
+    return best;
+}
+
+void PuzzlePool::workerLoop(unsigned int seed) {
+    // Board and solver are private to this worker
+    SudokuBoard board;
+    SudokuSolver solver(board);
+    solver.setSeed(seed);
+
+    // stop() interrupts a generation in progress instead of waiting for it
+    solver.setCancelFlag(&stopping);
+
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        int level;
+        wake.wait(guard, [this, &level]() {
+            level = levelToFill();
+            return stopping || level >= 0;
+        });
+        if (stopping) {
+            return;
+        }
+
+        // Generate without holding the lock
+        pending[level]++;
+        guard.unlock();
+
+        PuzzleGrid puzzle;
+        bool generated = solver.generatePuzzle(SudokuSolver::difficultyAt(level));
+        if (generated) {
+            board.getBoardState(puzzle.cells);
+        }
+
+        guard.lock();
+        pending[level]--;
+        if (!generated && stopping) {
+            return; // Cancelled by stop(), not a failed attempt to retry
+        }
+        if (generated) {
+            ready[level].push_back(puzzle);
+        }
+    }
+}
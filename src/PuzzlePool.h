@@ -0,0 +1,61 @@
+#ifndef PUZZLEPOOL_H
+#define PUZZLEPOOL_H
+
+#include "SudokuSolver.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A generated puzzle (0 = empty cell)
+struct PuzzleGrid {
+    int cells[9][9];
+};
+
+// Per-difficulty queues of ready puzzles, kept topped up by background worker threads
+// so a new game only has to pop one instead of generating it.
+class PuzzlePool {
+public:
+    static const int DEFAULT_DEPTH = 3;
+
+    explicit PuzzlePool(int depth = DEFAULT_DEPTH);
+    ~PuzzlePool();
+
+    // Pool used by the game
+    static PuzzlePool& shared();
+
+    // Start/stop the background workers
+    void start(int workerCount = 1);
+    void stop();
+
+    // Number of puzzles kept ready per difficulty
+    void setDepth(int depth);
+    int getDepth() const;
+
+    // Take a ready puzzle; returns false if none is available
+    bool tryPop(SudokuSolver::Difficulty difficulty, PuzzleGrid& puzzle);
+
+    // Number of ready puzzles for a difficulty
+    int available(SudokuSolver::Difficulty difficulty) const;
+
+private:
+    static const int NUM_LEVELS = SudokuSolver::NUM_DIFFICULTIES;
+
+    std::deque<PuzzleGrid> ready[NUM_LEVELS];
+    int pending[NUM_LEVELS];  // Puzzles being generated for each level
+    int targetDepth;
+    std::atomic<bool> stopping;  // Also the workers' cancel flag for generatePuzzle
+
+    mutable std::mutex lock;
+    std::condition_variable wake;
+    std::vector<std::thread> workers;
+
+    // Level that is furthest below the target depth, or -1 if all are full (lock held)
+    int levelToFill() const;
+
+    void workerLoop(unsigned int seed);
+};
+
+#endif // PUZZLEPOOL_H
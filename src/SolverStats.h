@@ -0,0 +1,38 @@
+#ifndef SOLVERSTATS_H
+#define SOLVERSTATS_H
+
+// Search counters for one top-level SudokuSolver call (solve, isSolvable,
+// countSolutions, hasUniqueSolution or generatePuzzle, including everything they call).
+//
+// Counting is compiled in only when SUDOKU_SOLVER_STATS is defined (for qmake:
+// DEFINES += SUDOKU_SOLVER_STATS). Otherwise the SOLVER_STAT statements expand to
+// nothing and every counter stays zero.
+struct SolverStats {
+    long long nodesVisited;          // Search nodes entered
+    long long backtracks;            // Values taken back after their subtree failed
+    int maxDepth;                    // Deepest search level reached
+    long long candidateEvaluations;  // Candidate values tried or scored
+    long long propagations;          // Placements whose constraints were pushed to peers
+    long long boardCopies;           // Full copies of the grid (snapshots, scratch grids, reloads)
+
+    SolverStats() {
+        reset();
+    }
+
+    void reset() {
+        nodesVisited = 0;
+        backtracks = 0;
+        maxDepth = 0;
+        candidateEvaluations = 0;
+        propagations = 0;
+        boardCopies = 0;
+    }
+};
+
+#ifdef SUDOKU_SOLVER_STATS
+#define SOLVER_STAT(...) __VA_ARGS__
+#else
+#define SOLVER_STAT(...)
+#endif
+
+#endif // SOLVERSTATS_H
@@ -1,87 +1,106 @@
-#include "SudokuBoard.h"
+#include "sudokuboard.h"
+#include "CandidateKernel.h"
+#include "BoardCodec.h"
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <type_traits>
+
+// Boards are copied by value (e.g. the player's initial board); no owned memory
+static_assert(std::is_trivially_copyable<SudokuBoard>::value, "SudokuBoard must copy with a memcpy");
+static_assert(std::is_trivially_copyable<SudokuBoard25>::value, "SudokuBoard25 must copy with a memcpy");
 
 // Constructor
-SudokuBoard::SudokuBoard() {
+template <int BoxSize>
+BasicSudokuBoard<BoxSize>::BasicSudokuBoard() : trailSize(0) {
     // Initialize the board with zeros
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
             board[row][col] = 0;
             fixedCells[row][col] = false;
         }
     }
+    resetCounts();
 
     // Initialize the constraint graph
     initializeGraph();
 }
 
 
-// Initialize the constraint graph with all vertices and edges
-void SudokuBoard::initializeGraph() {
-    // Add all cells as vertices
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
-            constraintGraph.addVertex(row, col);
-        }
+// Index of the box containing a cell
+template <int BoxSize>
+int BasicSudokuBoard<BoxSize>::boxIndex(int row, int col) {
+    return Geometry::boxIndex(row, col);
+}
+
+// Empty every row, column and box
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::resetCounts() {
+    for (int i = 0; i < SIZE; i++) {
+        rowUsed[i] = 0;
+        colUsed[i] = 0;
+        boxUsed[i] = 0;
     }
+    std::memset(rowCount, 0, sizeof(rowCount));
+    std::memset(colCount, 0, sizeof(colCount));
+    std::memset(boxCount, 0, sizeof(boxCount));
+    filledCount = 0;
+    conflictCount = 0;
+}
 
-    // Add all constraints as edges
-    addConstraints();
+// Count a digit placed in a cell; a second copy in a unit is a conflict
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::countPlaced(int row, int col, int value) {
+    int box = boxIndex(row, col);
+    int digit = value - 1;
+    Mask bit = maskBitOf<Mask>(value);
+    conflictCount += (rowCount[row][digit]++ > 0) + (colCount[col][digit]++ > 0) + (boxCount[box][digit]++ > 0);
+    rowUsed[row] |= bit;
+    colUsed[col] |= bit;
+    boxUsed[box] |= bit;
+    filledCount++;
 }
 
-// Add all constraints (edges) to the graph
-void SudokuBoard::addConstraints() {
-    // Row constraints
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
-            for (int otherCol = 0; otherCol < 9; otherCol++) {
-                if (col != otherCol) {
-                    constraintGraph.addEdge(row, col, row, otherCol);
-                }
-            }
-        }
+// Count a digit cleared from a cell; the used-digit bit goes with the unit's last copy
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::countCleared(int row, int col, int value) {
+    int box = boxIndex(row, col);
+    int digit = value - 1;
+    Mask keep = static_cast<Mask>(~maskBitOf<Mask>(value));
+    if (--rowCount[row][digit] > 0) {
+        conflictCount--;
+    } else {
+        rowUsed[row] &= keep;
     }
-
-    // Column constraints
-    for (int col = 0; col < 9; col++) {
-        for (int row = 0; row < 9; row++) {
-            for (int otherRow = 0; otherRow < 9; otherRow++) {
-                if (row != otherRow) {
-                    constraintGraph.addEdge(row, col, otherRow, col);
-                }
-            }
-        }
+    if (--colCount[col][digit] > 0) {
+        conflictCount--;
+    } else {
+        colUsed[col] &= keep;
+    }
+    if (--boxCount[box][digit] > 0) {
+        conflictCount--;
+    } else {
+        boxUsed[box] &= keep;
     }
+    filledCount--;
+}
 
-    // 3x3 box constraints
-    for (int boxRow = 0; boxRow < 3; boxRow++) {
-        for (int boxCol = 0; boxCol < 3; boxCol++) {
-            for (int cellRow = 0; cellRow < 3; cellRow++) {
-                for (int cellCol = 0; cellCol < 3; cellCol++) {
-                    int row = boxRow * 3 + cellRow;
-                    int col = boxCol * 3 + cellCol;
-
-                    // Connect to all other cells in the same 3x3 box
-                    for (int otherCellRow = 0; otherCellRow < 3; otherCellRow++) {
-                        for (int otherCellCol = 0; otherCellCol < 3; otherCellCol++) {
-                            int otherRow = boxRow * 3 + otherCellRow;
-                            int otherCol = boxCol * 3 + otherCellCol;
-
-                            if (row != otherRow || col != otherCol) {
-                                constraintGraph.addEdge(row, col, otherRow, otherCol);
-                            }
-                        }
-                    }
-                }
-            }
+// Initialize the constraint graph with all vertices and edges
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::initializeGraph() {
+    // Add all cells as vertices; the edges (peers) are fixed at compile time
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            constraintGraph.addVertex(row, col);
         }
     }
 }
 
 // Update the internal board array from the graph
-void SudokuBoard::updateBoardFromGraph() {
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::updateBoardFromGraph() {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
             if (constraintGraph.isSingleValue(row, col)) {
                 board[row][col] = constraintGraph.getValue(row, col);
             } else {
@@ -92,24 +111,37 @@ void SudokuBoard::updateBoardFromGraph() {
 }
 
 // Insert a value into the board
-bool SudokuBoard::insert(int row, int col, int value) {
-    if (row < 0 || row >= 9 || col < 0 || col >= 9 || value < 1 || value > 9) {
+template <int BoxSize>
+bool BasicSudokuBoard<BoxSize>::insert(int row, int col, int value) {
+    if (row < 0 || row >= SIZE || col < 0 || col >= SIZE || value < 1 || value > SIZE) {
         return false; // Invalid input
     }
 
     // Check if the value is in the domain of this cell
-    unorderedSet domain = calculateDomain(row, col);
-    if (!domain.contains(value)) {
+    if (!(calculateDomainMask(row, col) & maskBitOf<Mask>(value))) {
         return false; // Value not allowed in this cell
     }
 
+    if (board[row][col] == value) {
+        return true; // Already placed
+    }
+
+    // Overwriting a different value: release it first
+    if (board[row][col] != 0) {
+        remove(row, col);
+    }
+
     // Set the value in the constraint graph
     bool result = constraintGraph.setValue(row, col, value);
     if (result) {
-        // Propagate constraints to neighbors
-        propagateConstraints(row, col, value);
-        // Update the board array
+        // Propagate constraints to neighbors and log what changed
+        TrailEntry& entry = trail[trailSize++];
+        entry.changedPeers = propagateConstraints(row, col, value);
+        entry.cell = static_cast<typename Geometry::CellId>(row * SIZE + col);
+        entry.value = static_cast<unsigned char>(value);
+        // Update the board array and the unit counts
         board[row][col] = value;
+        countPlaced(row, col, value);
     }
 
     return result;
@@ -117,190 +149,383 @@ bool SudokuBoard::insert(int row, int col, int value) {
 
 
 // Propagate constraints after setting a value
-void SudokuBoard::propagateConstraints(int row, int col, int value) {
-    // Get all neighbors of this cell
-    CustomVector<CustomPair<int, int>> neighbors = constraintGraph.getNeighbors(row, col);
-
-    // Remove the value from the domains of all neighbors
-    for (int i = 0; i < neighbors.size(); i++) {
-        constraintGraph.removeFromDomain(neighbors[i].first, neighbors[i].second, value);
+template <int BoxSize>
+typename BasicSudokuBoard<BoxSize>::PeerMask BasicSudokuBoard<BoxSize>::propagateConstraints(int row, int col,
+                                                                                              int value) {
+    // Remove the value from every other cell in the same row, column and box
+    Mask bit = maskBitOf<Mask>(value);
+    PeerMask changed = 0;
+    typename GraphType::Span peers = constraintGraph.getNeighbors(row, col);
+    for (int i = 0; i < peers.size(); i++) {
+        int peerRow = peers[i] / SIZE;
+        int peerCol = peers[i] % SIZE;
+        if (constraintGraph.getDomainMask(peerRow, peerCol) & bit) {
+            constraintGraph.removeFromDomain(peerRow, peerCol, value);
+            changed |= static_cast<PeerMask>(1) << i;
+        }
     }
+    return changed;
 }
 
 // Remove a value from the board (reset cell)
-bool SudokuBoard::remove(int row, int col) {
-    if (row < 0 || row >= 9 || col < 0 || col >= 9) {
+template <int BoxSize>
+bool BasicSudokuBoard<BoxSize>::remove(int row, int col) {
+    if (row < 0 || row >= SIZE || col < 0 || col >= SIZE) {
         return false; // Invalid input
     }
 
-    // Reset the domain to all possible values
-    unorderedSet fullDomain;
-    for (int i = 1; i <= 9; i++) {
-        fullDomain.insert(i);
-    }
-
-    bool result = constraintGraph.setDomain(row, col, fullDomain);
+    // Domains no longer match the log
+    trailSize = 0;
 
-    if (result) {
-        // Update the board array
+    int value = board[row][col];
+    if (value != 0) {
+        // Release the digit from the unit counts and update the board array
+        countCleared(row, col, value);
         board[row][col] = 0;
+    }
 
-        // We need to recalculate the domains based on the current board state
-        recalculateDomains();
+    bool result = constraintGraph.setDomainMask(row, col, calculateDomainMask(row, col));
+
+    if (result && value != 0) {
+        // Only the peers can get the value back
+        restorePeerDomains(row, col);
     }
 
     return result;
 }
 
-// Recalculate all domains based on the current board state
-void SudokuBoard::recalculateDomains() {
-    // First, reset all domains for empty cells
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
-            if (board[row][col] == 0) {
-                unorderedSet fullDomain;
-                for (int i = 1; i <= 9; i++) {
-                    fullDomain.insert(i);
-                }
-                constraintGraph.setDomain(row, col, fullDomain);
-            }
+// Current trail position
+template <int BoxSize>
+int BasicSudokuBoard<BoxSize>::mark() const {
+    return trailSize;
+}
+
+// Take back the inserts made since a mark, newest first
+template <int BoxSize>
+bool BasicSudokuBoard<BoxSize>::undoTo(int trailMark) {
+    if (trailMark < 0 || trailMark > trailSize) {
+        return false; // Mark from before a reset
+    }
+
+    while (trailSize > trailMark) {
+        const TrailEntry& entry = trail[--trailSize];
+        PeerMask changedPeers = entry.changedPeers;
+        int row = entry.cell / SIZE;
+        int col = entry.cell % SIZE;
+
+        Mask bit = maskBitOf<Mask>(entry.value);
+        board[row][col] = 0;
+        countCleared(row, col, entry.value);
+
+        // Give the value back to exactly the peers that lost it
+        typename GraphType::Span peers = constraintGraph.getNeighbors(row, col);
+        while (changedPeers != 0) {
+            int peer = peers[lowestValue(changedPeers) - 1];
+            changedPeers &= changedPeers - 1;
+            int peerRow = peer / SIZE;
+            int peerCol = peer % SIZE;
+            constraintGraph.setDomainMask(peerRow, peerCol,
+                                          constraintGraph.getDomainMask(peerRow, peerCol) | bit);
+        }
+        constraintGraph.setDomainMask(row, col, calculateDomainMask(row, col));
+    }
+    return true;
+}
+
+// Recompute the domains of the empty peers of a cell from the used-digit masks
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::restorePeerDomains(int row, int col) {
+    for (int peer : constraintGraph.getNeighbors(row, col)) {
+        int peerRow = peer / SIZE;
+        int peerCol = peer % SIZE;
+        if (board[peerRow][peerCol] == 0) {
+            constraintGraph.setDomainMask(peerRow, peerCol, calculateDomainMask(peerRow, peerCol));
         }
     }
+}
 
-    // Then, propagate constraints from filled cells
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
-            if (board[row][col] != 0) {
-                propagateConstraints(row, col, board[row][col]);
+// Recalculate all domains based on the current board state
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::recalculateDomains() {
+    // The used-digit masks already hold every constraint, so each domain is one lookup
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            if (board[row][col] == 0) {
+                constraintGraph.setDomainMask(row, col, calculateDomainMask(row, col));
+            } else {
+                constraintGraph.setValue(row, col, board[row][col]);
             }
         }
     }
 }
 
 // Get the value at a specific position
-int SudokuBoard::getValue(int row, int col) const {
-    if (row < 0 || row >= 9 || col < 0 || col >= 9) {
+template <int BoxSize>
+int BasicSudokuBoard<BoxSize>::getValue(int row, int col) const {
+    if (row < 0 || row >= SIZE || col < 0 || col >= SIZE) {
         return -1; // Invalid input
     }
     return board[row][col];
 }
 
-unorderedSet SudokuBoard::calculateDomain(int row, int col) const {
-    unorderedSet domain;
-    // Start with full domain {1..9}
-    for (int i = 1; i <= 9; i++) {
-        domain.insert(i);
-    }
+template <int BoxSize>
+unorderedSet BasicSudokuBoard<BoxSize>::calculateDomain(int row, int col) const {
+    return maskToSet(calculateDomainMask(row, col));
+}
 
-    // Remove values from the same row
-    for (int c = 0; c < 9; c++) {
-        if (board[row][c] != 0 && c != col) {
-            domain.remove(board[row][c]);
-        }
+template <int BoxSize>
+typename BasicSudokuBoard<BoxSize>::Mask BasicSudokuBoard<BoxSize>::calculateDomainMask(int row, int col) const {
+    if (row < 0 || row >= SIZE || col < 0 || col >= SIZE) {
+        return 0; // Invalid input
     }
 
-    // Remove values from the same column
-    for (int r = 0; r < 9; r++) {
-        if (board[r][col] != 0 && r != row) {
-            domain.remove(board[r][col]);
-        }
+    Mask used = rowUsed[row] | colUsed[col] | boxUsed[boxIndex(row, col)];
+
+    // A filled cell does not constrain itself
+    if (board[row][col] != 0) {
+        used &= static_cast<Mask>(~maskBitOf<Mask>(board[row][col]));
     }
 
-    // Remove values from the same 3x3 box
-    int startRow = (row / 3) * 3;
-    int startCol = (col / 3) * 3;
-    for (int r = startRow; r < startRow + 3; r++) {
-        for (int c = startCol; c < startCol + 3; c++) {
-            if (board[r][c] != 0 && (r != row || c != col)) {
-                domain.remove(board[r][c]);
+    return static_cast<Mask>(ALL_VALUES & ~used);
+}
+
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::calculateAllDomainMasks(Mask masks[CELLS]) const {
+    if constexpr (BoxSize == 3) {
+        computeCandidates(&board[0][0], rowUsed, colUsed, boxUsed, masks);
+    } else {
+        for (int row = 0; row < SIZE; row++) {
+            for (int col = 0; col < SIZE; col++) {
+                masks[row * SIZE + col] = board[row][col] == 0 ? calculateDomainMask(row, col) : 0;
             }
         }
     }
+}
+
+// Get the domain of a cell
+template <int BoxSize>
+unorderedSet BasicSudokuBoard<BoxSize>::getDomain(int row, int col) const {
+    return constraintGraph.getDomain(row, col);
+}
 
-    return domain;
+// Get the domain of a cell as a bitmask
+template <int BoxSize>
+typename BasicSudokuBoard<BoxSize>::Mask BasicSudokuBoard<BoxSize>::getDomainMask(int row, int col) const {
+    return constraintGraph.getDomainMask(row, col);
 }
 
 
 // Print the current state of the board
-void SudokuBoard::printBoard() const {
-    std::cout << "-------------------------" << std::endl;
-    for (int row = 0; row < 9; row++) {
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::printBoard() const {
+    // Two characters per digit (three past 9) plus two per box border
+    const int cellWidth = SIZE > 9 ? 3 : 2;
+    const std::string separator(SIZE * cellWidth + 2 * BoxSize + 1, '-');
+    std::cout << separator << std::endl;
+    for (int row = 0; row < SIZE; row++) {
         std::cout << "| ";
-        for (int col = 0; col < 9; col++) {
+        for (int col = 0; col < SIZE; col++) {
+            if (cellWidth == 3 && (board[row][col] < 10)) {
+                std::cout << " ";
+            }
             if (board[row][col] == 0) {
                 std::cout << ". ";
             } else {
                 std::cout << board[row][col] << " ";
             }
-            if ((col + 1) % 3 == 0) {
+            if ((col + 1) % BoxSize == 0) {
                 std::cout << "| ";
             }
         }
         std::cout << std::endl;
-        if ((row + 1) % 3 == 0) {
-            std::cout << "-------------------------" << std::endl;
+        if ((row + 1) % BoxSize == 0) {
+            std::cout << separator << std::endl;
         }
     }
 }
 
 // Load a board from a 2D array
-void SudokuBoard::loadBoard(const int inputBoard[9][9]) {
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
-            if (inputBoard[row][col] != 0) {
-                insert(row, col, inputBoard[row][col]);
-                fixedCells[row][col] = true;  // Mark as fixed
-            } else {
-                // Make sure empty cells are properly reset
-                remove(row, col);
-                fixedCells[row][col] = false;
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::loadBoard(const int inputBoard[SIZE][SIZE]) {
+    trailSize = 0;
+    resetCounts();
+
+    // Place the clues and fill the unit counts
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            int value = inputBoard[row][col];
+            board[row][col] = 0;
+            fixedCells[row][col] = false;
+            if (value < 1 || value > SIZE) {
+                continue;
             }
+
+            board[row][col] = value;
+            fixedCells[row][col] = true;  // Mark as fixed
+            countPlaced(row, col, value);
         }
     }
+
+    // Then every domain from the finished masks
+    recalculateDomains();
+}
+
+// Save the complete board state
+template <int BoxSize>
+typename BasicSudokuBoard<BoxSize>::Snapshot BasicSudokuBoard<BoxSize>::snapshot() const {
+    Snapshot state;
+    std::memcpy(state.cells, board, sizeof(board));
+    std::memcpy(state.fixedCells, fixedCells, sizeof(fixedCells));
+    std::memcpy(state.rowUsed, rowUsed, sizeof(rowUsed));
+    std::memcpy(state.colUsed, colUsed, sizeof(colUsed));
+    std::memcpy(state.boxUsed, boxUsed, sizeof(boxUsed));
+    constraintGraph.getDomainMasks(state.domains);
+    std::memcpy(state.rowCount, rowCount, sizeof(rowCount));
+    std::memcpy(state.colCount, colCount, sizeof(colCount));
+    std::memcpy(state.boxCount, boxCount, sizeof(boxCount));
+    state.filledCount = filledCount;
+    state.conflictCount = conflictCount;
+    return state;
+}
+
+// Restore a state taken by snapshot()
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::restore(const Snapshot& state) {
+    std::memcpy(board, state.cells, sizeof(board));
+    std::memcpy(fixedCells, state.fixedCells, sizeof(fixedCells));
+    std::memcpy(rowUsed, state.rowUsed, sizeof(rowUsed));
+    std::memcpy(colUsed, state.colUsed, sizeof(colUsed));
+    std::memcpy(boxUsed, state.boxUsed, sizeof(boxUsed));
+    constraintGraph.setDomainMasks(state.domains);
+    std::memcpy(rowCount, state.rowCount, sizeof(rowCount));
+    std::memcpy(colCount, state.colCount, sizeof(colCount));
+    std::memcpy(boxCount, state.boxCount, sizeof(boxCount));
+    filledCount = state.filledCount;
+    conflictCount = state.conflictCount;
+    trailSize = 0;
 }
 
+// Load the clues of a packed puzzle straight from its bitmap
+template <int BoxSize>
+bool BasicSudokuBoard<BoxSize>::loadPacked(const PackedBoardView& packed) {
+    if constexpr (BoxSize != 3) {
+        (void)packed;
+        return false; // The packed format only encodes 9x9 puzzles
+    } else {
+        if (!packed.isValid()) {
+            return false;
+        }
+
+        std::memset(board, 0, sizeof(board));
+        std::memset(fixedCells, 0, sizeof(fixedCells));
+        resetCounts();
+        trailSize = 0;
+
+        // Visit only the clue cells, lowest bit first, placing them as loadBoard does
+        bool withSolution = packed.hasSolution();
+        int rank = 0;
+        for (int word = 0; word < 3; word++) {
+            uint32_t bits = packed.clueBits(word);
+            while (bits != 0) {
+                int cell = word * 32 + lowestValue(bits) - 1;
+                bits &= bits - 1;
+
+                int row = cell / SIZE;
+                int col = cell % SIZE;
+                int value = withSolution ? packed.solution(row, col) : packed.clueDigit(rank);
+                rank++;
+
+                board[row][col] = value;
+                fixedCells[row][col] = true;
+                countPlaced(row, col, value);
+            }
+        }
+
+        // Then every domain from the finished masks
+        recalculateDomains();
+        return conflictCount == 0;
+    }
+}
 
 // Get the graph for the solver to use
-const Graph& SudokuBoard::getGraph() const {
+template <int BoxSize>
+const typename BasicSudokuBoard<BoxSize>::GraphType& BasicSudokuBoard<BoxSize>::getGraph() const {
     return constraintGraph;
 }
 
 // Get a modifiable reference to the graph (for the solver)
-Graph& SudokuBoard::getGraphRef() {
+template <int BoxSize>
+typename BasicSudokuBoard<BoxSize>::GraphType& BasicSudokuBoard<BoxSize>::getGraphRef() {
     return constraintGraph;
 }
 
 // Get the current board state as a 2D array
-void SudokuBoard::getBoardState(int outputBoard[9][9]) const {
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::getBoardState(int outputBoard[SIZE][SIZE]) const {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
             outputBoard[row][col] = board[row][col];
         }
     }
 }
 
 // Check if a position is empty
-bool SudokuBoard::isEmpty(int row, int col) const {
-    if (row < 0 || row >= 9 || col < 0 || col >= 9) {
+template <int BoxSize>
+bool BasicSudokuBoard<BoxSize>::isEmpty(int row, int col) const {
+    if (row < 0 || row >= SIZE || col < 0 || col >= SIZE) {
         return false; // Invalid position
     }
     return board[row][col] == 0;
 }
 
 // Clear the entire board
-void SudokuBoard::clear() {
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
-            remove(row, col);
+template <int BoxSize>
+void BasicSudokuBoard<BoxSize>::clear() {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            board[row][col] = 0;
+            constraintGraph.setDomainMask(row, col, ALL_VALUES);
         }
     }
+    resetCounts();
+    trailSize = 0;
 }
 
 // Check if a cell is fixed (part of the original puzzle)
-bool SudokuBoard::isFixedCell(int row, int col) const {
-    if (row < 0 || row >= 9 || col < 0 || col >= 9) {
+template <int BoxSize>
+bool BasicSudokuBoard<BoxSize>::isFixedCell(int row, int col) const {
+    if (row < 0 || row >= SIZE || col < 0 || col >= SIZE) {
         return false; // Invalid position
     }
 
     return fixedCells[row][col];
 }
+
+// Number of filled cells
+template <int BoxSize>
+int BasicSudokuBoard<BoxSize>::filledCells() const {
+    return filledCount;
+}
+
+// Check if every cell is filled
+template <int BoxSize>
+bool BasicSudokuBoard<BoxSize>::isComplete() const {
+    return filledCount == CELLS;
+}
+
+// Check that no row, column or box repeats a digit
+template <int BoxSize>
+bool BasicSudokuBoard<BoxSize>::isValid() const {
+    return conflictCount == 0;
+}
+
+// Copies of a digit beyond the first in a row, column or box
+template <int BoxSize>
+int BasicSudokuBoard<BoxSize>::conflictingCells() const {
+    return conflictCount;
+}
+
+// 9x9, 16x16 and 25x25
+template class BasicSudokuBoard<3>;
+template class BasicSudokuBoard<4>;
+template class BasicSudokuBoard<5>;
@@ -3,33 +3,124 @@
 //
 
 #include "SudokuSolver.h"
+#include "CandidateKernel.h"
 #include <algorithm>
+#include <cstdlib>
 #include <vector>
 
 // Constructor initializes the random number generator and stores reference to board
-SudokuSolver::SudokuSolver(SudokuBoard& sudokuBoard) 
-    : board(sudokuBoard), rng(static_cast<unsigned int>(std::time(nullptr))) {
+template <int BoxSize>
+BasicSudokuSolver<BoxSize>::BasicSudokuSolver(Board& sudokuBoard, Strategy searchStrategy) 
+    : board(sudokuBoard), rng(static_cast<unsigned int>(std::time(nullptr))), strategy(searchStrategy),
+      puzzleRating(LogicSolver::RATING_EASY), puzzleTechniques(0), searchDepth(0), statsNesting(0),
+      cancelFlag(nullptr), progress(nullptr), generationAttempt(0) {
+    dlx.setStats(&stats);
 }
-SudokuBoard& SudokuSolver::getBoard() const {
+
+template <int BoxSize>
+BasicSudokuSolver<BoxSize>::StatsScope::StatsScope(BasicSudokuSolver<BoxSize>& solver) : owner(solver) {
+    if (owner.statsNesting++ == 0) {
+        owner.stats.reset();
+        owner.searchDepth = 0;
+    }
+}
+
+template <int BoxSize>
+BasicSudokuSolver<BoxSize>::StatsScope::~StatsScope() {
+    owner.statsNesting--;
+}
+
+template <int BoxSize>
+const SolverStats& BasicSudokuSolver<BoxSize>::getLastStats() const {
+    return stats;
+}
+
+template <int BoxSize>
+typename BasicSudokuSolver<BoxSize>::Board& BasicSudokuSolver<BoxSize>::getBoard() const {
     return board;
 }
 
+template <int BoxSize>
+void BasicSudokuSolver<BoxSize>::setStrategy(Strategy searchStrategy) {
+    strategy = searchStrategy;
+}
+
+template <int BoxSize>
+typename BasicSudokuSolver<BoxSize>::Strategy BasicSudokuSolver<BoxSize>::getStrategy() const {
+    return strategy;
+}
+
+template <int BoxSize>
+void BasicSudokuSolver<BoxSize>::setSeed(unsigned int seed) {
+    rng.seed(seed);
+}
+
+template <int BoxSize>
+void BasicSudokuSolver<BoxSize>::setCancelFlag(const std::atomic<bool>* flag) {
+    cancelFlag = flag;
+}
+
+template <int BoxSize>
+void BasicSudokuSolver<BoxSize>::setProgress(std::atomic<int>* percent) {
+    progress = percent;
+}
+
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::cancelled() const {
+    return cancelFlag != nullptr && cancelFlag->load(std::memory_order_relaxed);
+}
+
+template <int BoxSize>
+void BasicSudokuSolver<BoxSize>::reportProgress(int percent) {
+    if (progress != nullptr) {
+        progress->store(percent, std::memory_order_relaxed);
+    }
+}
+
 // Main solving algorithm using backtracking
-bool SudokuSolver::solve() {
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::solve() {
+    SOLVER_STAT(StatsScope scope(*this);)
+
+    // Conflicting clues have no solution, however the empty cells are filled
+    if (!board.isValid()) {
+        return false;
+    }
+
+    if (strategy == MRV_LCV) {
+        return solveMRV();
+    }
+    if (strategy == DANCING_LINKS) {
+        return solveDLX();
+    }
+
     // Start solving from the top-left corner
     return solveRecursive(0, 0);
 }
 
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::solve(SolverStats& searchStats) {
+    bool solved = solve();
+    searchStats = stats;
+    return solved;
+}
+
 // Recursive helper for the solving algorithm
-bool SudokuSolver::solveRecursive(int row, int col) {
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::solveRecursive(int row, int col) {
+    SOLVER_STAT(
+        stats.nodesVisited++;
+        stats.maxDepth = std::max(stats.maxDepth, searchDepth);
+    )
+
     // If we've filled the entire board, we're done
-    if (row == 9) {
+    if (row == SIZE) {
         return true;
     }
     
     // Move to the next cell
-    int nextRow = (col == 8) ? row + 1 : row;
-    int nextCol = (col == 8) ? 0 : col + 1;
+    int nextRow = (col == SIZE - 1) ? row + 1 : row;
+    int nextCol = (col == SIZE - 1) ? 0 : col + 1;
     
     // If this cell already has a value, move to the next one
     if (!board.isEmpty(row, col)) {
@@ -37,17 +128,27 @@ bool SudokuSolver::solveRecursive(int row, int col) {
     }
     
     // Try each possible value for this cell
-    for (int num = 1; num <= 9; num++) {
+    for (int num = 1; num <= SIZE; num++) {
+        SOLVER_STAT(stats.candidateEvaluations++;)
         if (isValidMove(row, col, num)) {
             // Place this value in the cell
+            int trailMark = board.mark();
             if (board.insert(row, col, num)) {
+                SOLVER_STAT(
+                    stats.propagations++;
+                    searchDepth++;
+                )
+
                 // Recursively try to solve the rest of the board
-                if (solveRecursive(nextRow, nextCol)) {
+                bool solved = solveRecursive(nextRow, nextCol);
+                SOLVER_STAT(searchDepth--;)
+                if (solved) {
                     return true;
                 }
                 
                 // If we couldn't solve with this value, backtrack
-                board.remove(row, col);
+                board.undoTo(trailMark);
+                SOLVER_STAT(stats.backtracks++;)
             }
         }
     }
@@ -56,10 +157,171 @@ bool SudokuSolver::solveRecursive(int row, int col) {
     return false;
 }
 
+// Backtracking that always branches on the most constrained cell
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::solveMRV() {
+    SOLVER_STAT(
+        stats.nodesVisited++;
+        stats.maxDepth = std::max(stats.maxDepth, searchDepth);
+    )
+
+    int row, col;
+    Mask candidates;
+    if (!selectMRVCell(row, col, candidates)) {
+        return true; // No empty cells left
+    }
+
+    // Try the values that leave the most room for the peers first
+    int values[SIZE];
+    int count = orderValuesLCV(row, col, candidates, values);
+    SOLVER_STAT(stats.candidateEvaluations += count;)
+    int trailMark = board.mark();
+    for (int i = 0; i < count; i++) {
+        if (board.insert(row, col, values[i])) {
+            SOLVER_STAT(
+                stats.propagations++;
+                searchDepth++;
+            )
+            bool solved = solveMRV();
+            SOLVER_STAT(searchDepth--;)
+            if (solved) {
+                return true;
+            }
+
+            // Backtrack: undo just this insert
+            board.undoTo(trailMark);
+            SOLVER_STAT(stats.backtracks++;)
+        }
+    }
+
+    // Either a dead end (empty domain) or every value failed
+    return false;
+}
+
+// Solve with the exact-cover engine and copy the solution onto the board
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::solveDLX() {
+    int currentBoard[SIZE][SIZE];
+    board.getBoardState(currentBoard);
+    SOLVER_STAT(stats.boardCopies++;)
+
+    int solution[SIZE][SIZE];
+    if (!dlx.load(currentBoard) || !dlx.solve(solution)) {
+        return false;
+    }
+
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            if (board.isEmpty(row, col)) {
+                board.insert(row, col, solution[row][col]);
+            }
+        }
+    }
+
+    return true;
+}
+
+// Pick the empty cell with the fewest candidates (ties go to the first in row-major order)
+// Returns false when the board has no empty cells
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::selectMRVCell(int& row, int& col, Mask& candidates) const {
+    int bestCount = SIZE + 1; // More than maximum possible (SIZE)
+    row = -1;
+    col = -1;
+    candidates = 0;
+
+    Mask masks[CELLS];
+    board.calculateAllDomainMasks(masks);
+
+    for (int r = 0; r < SIZE; r++) {
+        for (int c = 0; c < SIZE; c++) {
+            if (!board.isEmpty(r, c)) {
+                continue;
+            }
+
+            Mask mask = masks[r * SIZE + c];
+            int count = countBits(mask);
+            if (count < bestCount) {
+                bestCount = count;
+                row = r;
+                col = c;
+                candidates = mask;
+
+                // Cannot do better than a dead end or a forced value
+                if (count <= 1) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return row != -1;
+}
+
+// Order the candidates of a cell by how few peer candidates they would eliminate
+// (ties go to the smaller value); returns the number of values written
+template <int BoxSize>
+int BasicSudokuSolver<BoxSize>::orderValuesLCV(int row, int col, Mask candidates, int values[SIZE]) const {
+    int scores[SIZE];
+    int count = 0;
+
+    for (int val = 1; val <= SIZE; val++) {
+        if (!(candidates & maskBitOf<Mask>(val))) {
+            continue;
+        }
+
+        int score = countPeerCandidates(row, col, val);
+
+        // Insertion sort keeps the order stable for equal scores
+        int pos = count;
+        while (pos > 0 && scores[pos - 1] > score) {
+            scores[pos] = scores[pos - 1];
+            values[pos] = values[pos - 1];
+            pos--;
+        }
+        scores[pos] = score;
+        values[pos] = val;
+        count++;
+    }
+
+    return count;
+}
+
+// Count the empty peers of a cell that still have a value as a candidate
+template <int BoxSize>
+int BasicSudokuSolver<BoxSize>::countPeerCandidates(int row, int col, int val) const {
+    Mask bit = maskBitOf<Mask>(val);
+    int count = 0;
+
+    // Row and column peers
+    for (int i = 0; i < SIZE; i++) {
+        if (i != col && board.isEmpty(row, i) && (board.calculateDomainMask(row, i) & bit)) {
+            count++;
+        }
+        if (i != row && board.isEmpty(i, col) && (board.calculateDomainMask(i, col) & bit)) {
+            count++;
+        }
+    }
+
+    // Box peers not already counted in the row or column
+    int startRow = (row / BoxSize) * BoxSize;
+    int startCol = (col / BoxSize) * BoxSize;
+    for (int r = startRow; r < startRow + BoxSize; r++) {
+        for (int c = startCol; c < startCol + BoxSize; c++) {
+            if (r != row && c != col && board.isEmpty(r, c) && (board.calculateDomainMask(r, c) & bit)) {
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
 // Find the first empty cell on the board
-std::pair<int, int> SudokuSolver::findEmptyCell() const {
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
+template <int BoxSize>
+std::pair<int, int> BasicSudokuSolver<BoxSize>::findEmptyCell() const {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
             if (board.isEmpty(row, col)) {
                 return std::make_pair(row, col);
             }
@@ -69,26 +331,27 @@ std::pair<int, int> SudokuSolver::findEmptyCell() const {
 }
 
 // Check if a specific move is valid based on Sudoku rules
-bool SudokuSolver::isValidMove(int row, int col, int val) const {
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::isValidMove(int row, int col, int val) const {
     // Check row
-    for (int c = 0; c < 9; c++) {
+    for (int c = 0; c < SIZE; c++) {
         if (board.getValue(row, c) == val && c != col) {
             return false;
         }
     }
 
     // Check column
-    for (int r = 0; r < 9; r++) {
+    for (int r = 0; r < SIZE; r++) {
         if (board.getValue(r, col) == val && r != row) {
             return false;
         }
     }
 
-    // Check 3x3 box
-    int startRow = (row / 3) * 3;
-    int startCol = (col / 3) * 3;
-    for (int r = startRow; r < startRow + 3; r++) {
-        for (int c = startCol; c < startCol + 3; c++) {
+    // Check box
+    int startRow = (row / BoxSize) * BoxSize;
+    int startCol = (col / BoxSize) * BoxSize;
+    for (int r = startRow; r < startRow + BoxSize; r++) {
+        for (int c = startCol; c < startCol + BoxSize; c++) {
             if (board.getValue(r, c) == val && (r != row || c != col)) {
                 return false;
             }
@@ -100,60 +363,56 @@ bool SudokuSolver::isValidMove(int row, int col, int val) const {
 
 
 // Check if the current board is solvable
-bool SudokuSolver::isSolvable() {
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::isSolvable() {
+    SOLVER_STAT(StatsScope scope(*this);)
+
     // Save the current state
-    int currentBoard[9][9];
-    board.getBoardState(currentBoard);
+    typename Board::Snapshot saved = board.snapshot();
     
     // Try to solve it
     bool solvable = solve();
     
     // Restore the original state
-    board.loadBoard(currentBoard);
+    board.restore(saved);
+    SOLVER_STAT(stats.boardCopies += 2;)
     
     return solvable;
 }
 
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::isSolvable(SolverStats& searchStats) {
+    bool solvable = isSolvable();
+    searchStats = stats;
+    return solvable;
+}
+
 // Check if the current board configuration is valid
-bool SudokuSolver::isValidBoard() const {
-    // Check each cell that has a value
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
-            int val = board.getValue(row, col);
-            if (val != 0) {
-                // Temporarily remove the value
-                const_cast<SudokuBoard&>(board).remove(row, col);
-                
-                // Check if it would be valid to place it again
-                bool valid = isValidMove(row, col, val);
-                
-                // Put it back
-                const_cast<SudokuBoard&>(board).insert(row, col, val);
-                
-                if (!valid) {
-                    return false;
-                }
-            }
-        }
-    }
-    return true;
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::isValidBoard() const {
+    // The board counts repeated digits per unit, so no cell has to be revisited
+    return board.isValid();
 }
 
 // Generate a fully solved random board
-bool SudokuSolver::generateSolvedBoard() {
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::generateSolvedBoard() {
     // Start with an empty board
     board.clear();
     
-    // Fill the diagonal 3x3 boxes first (these don't affect each other)
-    for (int box = 0; box < 3; box++) {
-        std::vector<int> nums = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    // Fill the diagonal boxes first (these don't affect each other)
+    for (int box = 0; box < BoxSize; box++) {
+        std::vector<int> nums(SIZE);
+        for (int i = 0; i < SIZE; i++) {
+            nums[i] = i + 1;
+        }
         std::shuffle(nums.begin(), nums.end(), rng);
         
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                int row = box * 3 + i;
-                int col = box * 3 + j;
-                board.insert(row, col, nums[i * 3 + j]);
+        for (int i = 0; i < BoxSize; i++) {
+            for (int j = 0; j < BoxSize; j++) {
+                int row = box * BoxSize + i;
+                int col = box * BoxSize + j;
+                board.insert(row, col, nums[i * BoxSize + j]);
             }
         }
     }
@@ -162,25 +421,136 @@ bool SudokuSolver::generateSolvedBoard() {
     return solve();
 }
 
+// Technique rating a difficulty level asks for
+LogicSolver::Rating SudokuSolverBase::targetRating(Difficulty difficulty) {
+    switch (difficulty) {
+        case EASY:
+            return LogicSolver::RATING_EASY;
+        case MEDIUM:
+            return LogicSolver::RATING_MEDIUM;
+        case HARD:
+            return LogicSolver::RATING_HARD;
+        case EXPERT:
+            return LogicSolver::RATING_EXPERT;
+    }
+    return LogicSolver::RATING_MEDIUM;
+}
+
+int SudokuSolverBase::difficultyIndex(Difficulty difficulty) {
+    switch (difficulty) {
+        case EASY:
+            return 0;
+        case MEDIUM:
+            return 1;
+        case HARD:
+            return 2;
+        case EXPERT:
+            return 3;
+    }
+    return 1;
+}
+
+SudokuSolverBase::Difficulty SudokuSolverBase::difficultyAt(int index) {
+    static const Difficulty levels[NUM_DIFFICULTIES] = { EASY, MEDIUM, HARD, EXPERT };
+    return levels[index];
+}
+
 // Generate a new puzzle with the specified difficulty
-bool SudokuSolver::generatePuzzle(Difficulty difficulty) {
-    // First generate a solved board
-    if (!generateSolvedBoard()) {
-        return false;
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::generatePuzzle(Difficulty difficulty) {
+    SOLVER_STAT(StatsScope scope(*this);)
+
+    LogicSolver::Rating target = targetRating(difficulty);
+
+    // Keep the candidate whose rating is closest to the target
+    typename Board::Snapshot bestBoard;
+    int bestDistance = -1;
+    bool bestIsCurrent = false;
+
+    reportProgress(0);
+    for (int attempt = 0; attempt < MAX_GRADING_ATTEMPTS; attempt++) {
+        generationAttempt = attempt;
+
+        // First generate a solved board
+        if (cancelled() || !generateSolvedBoard()) {
+            return false;
+        }
+
+        // Then remove numbers based on difficulty
+        LogicSolver::Rating rating = removeNumbers(difficulty, target);
+        if (cancelled()) {
+            return false;
+        }
+
+        int distance = std::abs(static_cast<int>(rating) - static_cast<int>(target));
+        bestIsCurrent = bestDistance == -1 || distance < bestDistance;
+        if (bestIsCurrent) {
+            bestDistance = distance;
+            bestBoard = board.snapshot();
+            puzzleRating = rating;
+            if constexpr (BoxSize == 3) {
+                puzzleTechniques = logic.solve(bestBoard.cells).techniques;
+            } else {
+                puzzleTechniques = 0;
+            }
+            SOLVER_STAT(stats.boardCopies += 2;)
+        }
+        if (distance == 0) {
+            break;
+        }
     }
-    
-    // Then remove numbers based on difficulty
-    removeNumbers(difficulty);
-    
+
+    // An earlier candidate was closer than the last one
+    if (!bestIsCurrent) {
+        board.restore(bestBoard);
+        SOLVER_STAT(stats.boardCopies++;)
+    }
+
+    reportProgress(100);
     return true;
 }
 
-// Remove numbers from a solved board to create a puzzle
-void SudokuSolver::removeNumbers(int difficulty) {
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::generatePuzzle(Difficulty difficulty, SolverStats& searchStats) {
+    bool generated = generatePuzzle(difficulty);
+    searchStats = stats;
+    return generated;
+}
+
+template <int BoxSize>
+LogicSolver::Rating BasicSudokuSolver<BoxSize>::getPuzzleRating() const {
+    return puzzleRating;
+}
+
+template <int BoxSize>
+unsigned int BasicSudokuSolver<BoxSize>::getPuzzleTechniques() const {
+    return puzzleTechniques;
+}
+
+// Technique rating of the current board (RATING_EXPERT on grids LogicSolver cannot grade)
+template <int BoxSize>
+LogicSolver::Rating BasicSudokuSolver<BoxSize>::gradeBoard() {
+    if constexpr (BoxSize != 3) {
+        return LogicSolver::RATING_EXPERT;
+    } else {
+        int currentBoard[SIZE][SIZE];
+        board.getBoardState(currentBoard);
+        SOLVER_STAT(stats.boardCopies += 2;)
+        return logic.solve(currentBoard).rating;
+    }
+}
+
+// Remove numbers from a solved board to create a puzzle. A removal is kept only if the
+// solution stays unique and the technique rating does not go above the target; digging
+// stops once `difficulty` cells (scaled from 81 to the grid) are empty and the target
+// rating is reached. Grids LogicSolver cannot grade skip the rating check and report
+// the target. Returns the final rating.
+template <int BoxSize>
+LogicSolver::Rating BasicSudokuSolver<BoxSize>::removeNumbers(int difficulty, LogicSolver::Rating target) {
     // Create a list of all positions
     std::vector<std::pair<int, int>> positions;
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
             positions.push_back(std::make_pair(row, col));
         }
     }
@@ -190,10 +560,13 @@ void SudokuSolver::removeNumbers(int difficulty) {
     
     // Keep track of how many cells we've emptied
     int removed = 0;
+    int toRemove = difficulty * CELLS / 81;
+    const bool graded = BoxSize == 3;
+    LogicSolver::Rating rating = graded ? LogicSolver::RATING_EASY : target;
     
     // Try to remove numbers while maintaining a unique solution
     for (const auto& pos : positions) {
-        if (removed >= difficulty) {
+        if ((removed >= toRemove && rating >= target) || cancelled()) {
             break;
         }
         
@@ -204,54 +577,200 @@ void SudokuSolver::removeNumbers(int difficulty) {
         // Try removing this number
         board.remove(row, col);
         
-        // If the board still has a unique solution, keep it removed
-        if (hasUniqueSolution()) {
-            removed++;
-        } else {
-            // Otherwise, put it back
+        // Keep it removed only if the solution is still unique and not too hard
+        if (countSolutions(2) != 1) {
             board.insert(row, col, val);
+            continue;
+        }
+
+        if (graded) {
+            LogicSolver::Rating newRating = gradeBoard();
+            if (newRating > target) {
+                board.insert(row, col, val);
+                continue;
+            }
+            rating = newRating;
         }
+
+        removed++;
+        int total = MAX_GRADING_ATTEMPTS * std::max(toRemove, 1);
+        int done = generationAttempt * std::max(toRemove, 1) + std::min(removed, toRemove);
+        reportProgress(std::min(done * 100 / total, 99));
     }
+
+    return rating;
 }
 
 // Check if the current board has exactly one solution
-bool SudokuSolver::hasUniqueSolution() {
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::hasUniqueSolution() {
+    return countSolutions(2) == 1;
+}
 
-    // a full implementation would optimize by detecting multiple solutions early
-    
-    // Save the current state
-    int currentBoard[9][9];
-    board.getBoardState(currentBoard);
-    
-    // Check if it's solvable
-    bool solvable = solve();
-    if (!solvable) {
-        // Restore original board
-        board.loadBoard(currentBoard);
-        return false;
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::hasUniqueSolution(SolverStats& searchStats) {
+    bool unique = hasUniqueSolution();
+    searchStats = stats;
+    return unique;
+}
+
+// Count solutions up to limit on a scratch copy of the board
+template <int BoxSize>
+int BasicSudokuSolver<BoxSize>::countSolutions(int limit) {
+    SOLVER_STAT(StatsScope scope(*this);)
+
+    if (limit <= 0) {
+        return 0;
     }
-    
-    // Save the solved state
-    int solvedBoard[9][9];
-    board.getBoardState(solvedBoard);
-    
-    // Restore the original board
-    board.loadBoard(currentBoard);
-    
-    return solvable;
+
+    if (strategy == DANCING_LINKS) {
+        int currentBoard[SIZE][SIZE];
+        board.getBoardState(currentBoard);
+        SOLVER_STAT(stats.boardCopies++;)
+        if (!dlx.load(currentBoard)) {
+            return 0;
+        }
+        return dlx.countSolutions(limit);
+    }
+
+    ScratchGrid grid;
+    SOLVER_STAT(stats.boardCopies++;)
+    if (!loadScratch(grid)) {
+        return 0; // Givens already conflict
+    }
+    return countScratch(grid, limit);
+}
+
+// Copy the board into a scratch grid; returns false if two givens conflict
+template <int BoxSize>
+bool BasicSudokuSolver<BoxSize>::loadScratch(ScratchGrid& grid) const {
+    for (int i = 0; i < SIZE; i++) {
+        grid.rowUsed[i] = 0;
+        grid.colUsed[i] = 0;
+        grid.boxUsed[i] = 0;
+    }
+
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            int val = board.getValue(row, col);
+            grid.cells[row * SIZE + col] = val;
+            if (val == 0) {
+                continue;
+            }
+
+            Mask bit = maskBitOf<Mask>(val);
+            int box = Board::Geometry::boxIndex(row, col);
+            if ((grid.rowUsed[row] | grid.colUsed[col] | grid.boxUsed[box]) & bit) {
+                return false;
+            }
+            grid.rowUsed[row] |= bit;
+            grid.colUsed[col] |= bit;
+            grid.boxUsed[box] |= bit;
+        }
+    }
+
+    return true;
+}
+
+// MRV backtracking over the scratch grid that stops as soon as limit solutions are found
+template <int BoxSize>
+int BasicSudokuSolver<BoxSize>::countScratch(ScratchGrid& grid, int limit) const {
+    SOLVER_STAT(
+        stats.nodesVisited++;
+        stats.maxDepth = std::max(stats.maxDepth, searchDepth);
+    )
+
+    int bestCell = -1;
+    int bestCount = SIZE + 1;
+    Mask bestMask = 0;
+
+    Mask masks[CELLS];
+    if constexpr (BoxSize == 3) {
+        computeCandidates(grid.cells, grid.rowUsed, grid.colUsed, grid.boxUsed, masks);
+    } else {
+        for (int cell = 0; cell < CELLS; cell++) {
+            int row = cell / SIZE;
+            int col = cell % SIZE;
+            Mask used = grid.rowUsed[row] | grid.colUsed[col] | grid.boxUsed[Board::Geometry::boxIndex(row, col)];
+            masks[cell] = grid.cells[cell] == 0 ? static_cast<Mask>(Board::ALL_VALUES & ~used) : 0;
+        }
+    }
+
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (grid.cells[cell] != 0) {
+            continue;
+        }
+
+        Mask mask = masks[cell];
+        int count = countBits(mask);
+        if (count == 0) {
+            return 0; // Dead end
+        }
+        if (count < bestCount) {
+            bestCount = count;
+            bestCell = cell;
+            bestMask = mask;
+            if (count == 1) {
+                break;
+            }
+        }
+    }
+
+    if (bestCell == -1) {
+        return 1; // Board is full: one solution
+    }
+
+    int row = bestCell / SIZE;
+    int col = bestCell % SIZE;
+    int box = Board::Geometry::boxIndex(row, col);
+    int total = 0;
+
+    while (bestMask != 0 && total < limit) {
+        Mask bit = static_cast<Mask>(bestMask & (~bestMask + 1));
+        bestMask &= bestMask - 1;
+
+        grid.cells[bestCell] = lowestValue(bit);
+        grid.rowUsed[row] |= bit;
+        grid.colUsed[col] |= bit;
+        grid.boxUsed[box] |= bit;
+        SOLVER_STAT(
+            stats.candidateEvaluations++;
+            stats.propagations++;
+            searchDepth++;
+        )
+
+        int found = countScratch(grid, limit - total);
+        total += found;
+        SOLVER_STAT(
+            searchDepth--;
+            if (found == 0) {
+                stats.backtracks++;
+            }
+        )
+
+        grid.cells[bestCell] = 0;
+        grid.rowUsed[row] &= static_cast<Mask>(~bit);
+        grid.colUsed[col] &= static_cast<Mask>(~bit);
+        grid.boxUsed[box] &= static_cast<Mask>(~bit);
+    }
+
+    return total;
 }
 
 // Get a hint for the next move
-std::pair<int, int> SudokuSolver::getHint() {
+template <int BoxSize>
+std::pair<int, int> BasicSudokuSolver<BoxSize>::getHint() {
     // Find an empty cell that has the smallest domain (fewest possibilities)
-    int minDomainSize = 10; // More than maximum possible (9)
+    int minDomainSize = SIZE + 1; // More than maximum possible (SIZE)
     std::pair<int, int> bestCell(-1, -1);
 
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
+    Mask masks[CELLS];
+    board.calculateAllDomainMasks(masks);
+
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
             if (board.isEmpty(row, col)) {
-                unorderedSet domain = board.calculateDomain(row, col);
-                int domainSize = domain.size();
+                int domainSize = countBits(masks[row * SIZE + col]);
 
                 // If we find a cell with domain size 1, that's an immediate hint
                 if (domainSize == 1) {
@@ -273,8 +792,8 @@ std::pair<int, int> SudokuSolver::getHint() {
     }
 
     // Fallback to finding any empty cell
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
             if (board.isEmpty(row, col)) {
                 return std::make_pair(row, col);
             }
@@ -283,3 +802,8 @@ std::pair<int, int> SudokuSolver::getHint() {
 
     return std::make_pair(-1, -1); // No empty cells found
 }
+
+// 9x9, 16x16 and 25x25
+template class BasicSudokuSolver<3>;
+template class BasicSudokuSolver<4>;
+template class BasicSudokuSolver<5>;
@@ -5,47 +5,143 @@
 #ifndef SUDOKUSOLVER_H
 #define SUDOKUSOLVER_H
 
-#include "SudokuBoard.h"
+#include "sudokuboard.h"
+#include "DancingLinks.h"
+#include "LogicSolver.h"
+#include "SolverStats.h"
+#include <atomic>
 #include <vector>
 #include <utility>
 #include <random>
 #include <ctime>
 
-class SudokuSolver {
+// Enums and settings shared by the solvers of every board size
+class SudokuSolverBase {
+public:
+    // Search strategies used by solve()
+    enum Strategy {
+        ROW_MAJOR,  // Cells in row-major order, values 1..SIZE
+        MRV_LCV,        // Fewest-candidates cell first, least-constraining value first
+        DANCING_LINKS   // Exact-cover search (Algorithm X)
+    };
+
+    // Difficulty levels (minimum number of empty cells of a 9x9 puzzle, scaled by the
+    // cell count on larger grids); each also has a target technique rating, see
+    // targetRating()
+    enum Difficulty {
+        EASY = 35,    // 35 empty cells
+        MEDIUM = 45,  // 45 empty cells
+        HARD = 55,    // 55 empty cells
+        EXPERT = 64   // 64 empty cells
+    };
+
+    // Candidate puzzles generated before settling for the closest rating
+    static const int MAX_GRADING_ATTEMPTS = 20;
+
+    // Technique rating a difficulty level asks for
+    static LogicSolver::Rating targetRating(Difficulty difficulty);
+
+    // Difficulty levels as indices 0 (EASY) to NUM_DIFFICULTIES - 1 (EXPERT)
+    static const int NUM_DIFFICULTIES = 4;
+    static int difficultyIndex(Difficulty difficulty);
+    static Difficulty difficultyAt(int index);
+};
+
+// Solver and generator for a board with BoxSize x BoxSize boxes. Instantiated for 9x9,
+// 16x16 and 25x25; technique grading (LogicSolver) is 9x9 only, so larger puzzles are
+// dug by clue count alone.
+template <int BoxSize>
+class BasicSudokuSolver : public SudokuSolverBase {
+public:
+    typedef BasicSudokuBoard<BoxSize> Board;
+    typedef typename Board::Mask Mask;
+
+    static const int SIZE = Board::SIZE;
+    static const int CELLS = Board::CELLS;
+
 private:
-    SudokuBoard& board;
+    Board& board;
     std::mt19937 rng; 
+    Strategy strategy;
+    BasicDancingLinks<BoxSize> dlx;
+    LogicSolver logic;
+
+    // Technique grade of the last generated puzzle
+    LogicSolver::Rating puzzleRating;
+    unsigned int puzzleTechniques;
+
+    // Counters of the current/last top-level call (see SolverStats.h)
+    mutable SolverStats stats;
+    mutable int searchDepth;
+    int statsNesting;
+
+    // Generation control (see setCancelFlag/setProgress); nullptr when detached
+    const std::atomic<bool>* cancelFlag;
+    std::atomic<int>* progress;
+    int generationAttempt;  // Attempt of generatePuzzle in progress, for reportProgress
+    bool cancelled() const;
+    void reportProgress(int percent);
+
+    // Resets the counters when a top-level call starts (not for nested calls)
+    struct StatsScope {
+        explicit StatsScope(BasicSudokuSolver& solver);
+        ~StatsScope();
+        BasicSudokuSolver& owner;
+    };
+
+    // Flat copy of the givens used by countSolutions, so the live board is never touched
+    struct ScratchGrid {
+        int cells[CELLS];
+        Mask rowUsed[SIZE];
+        Mask colUsed[SIZE];
+        Mask boxUsed[SIZE];
+    };
     
     // Helper fucntions for solving
     bool solveRecursive(int row, int col);
+    bool solveMRV();
+    bool solveDLX();
+    bool selectMRVCell(int& row, int& col, Mask& candidates) const;
+    int orderValuesLCV(int row, int col, Mask candidates, int values[SIZE]) const;
+    int countPeerCandidates(int row, int col, int val) const;
+    bool loadScratch(ScratchGrid& grid) const;
+    int countScratch(ScratchGrid& grid, int limit) const;
     std::pair<int, int> findEmptyCell() const;
     bool isValidMove(int row, int col, int val) const;
     
     // helper fucntions
-    void removeNumbers(int difficulty);
-    bool hasUniqueSolution();
+    LogicSolver::Rating removeNumbers(int difficulty, LogicSolver::Rating target);
+    LogicSolver::Rating gradeBoard();
     
 public:
-    // Difficulty levels
-    enum Difficulty {
-        EASY = 35,    // 35 empty cells
-        MEDIUM = 45,  // 45 empty cells
-        HARD = 55,    // 55 empty cells
-        EXPERT = 64   // 64 empty cells
-    };
-    
-    // Constructor takes a reference to an existing SudokuBoard
-    explicit SudokuSolver(SudokuBoard& sudokuBoard);
+    // Constructor takes a reference to an existing board
+    explicit BasicSudokuSolver(Board& sudokuBoard, Strategy searchStrategy = MRV_LCV);
+
+    Board& getBoard() const;
 
-    SudokuBoard& getBoard() const;
+    // Select the search strategy used by solve()
+    void setStrategy(Strategy searchStrategy);
+    Strategy getStrategy() const;
+
+    // Reseed the random generator (solvers created in the same second share a seed)
+    void setSeed(unsigned int seed);
     
     // Solve the current board
     bool solve();
+    bool solve(SolverStats& searchStats);
     
     // Check if the board is solvable
     bool isSolvable();
+    bool isSolvable(SolverStats& searchStats);
+
+    // Count the solutions of the current board, stopping once limit are found
+    int countSolutions(int limit);
+
+    // Check if the current board has exactly one solution
+    bool hasUniqueSolution();
+    bool hasUniqueSolution(SolverStats& searchStats);
     
-    // Check if the current board configuration is valid
+    // Check that no row, column or box of the board repeats a digit (O(1))
     bool isValidBoard() const;
     
     // Generate a new random solved board
@@ -53,9 +149,36 @@ public:
     
     // Generate a new puzzle with the specified difficulty
     bool generatePuzzle(Difficulty difficulty);
+    bool generatePuzzle(Difficulty difficulty, SolverStats& searchStats);
+
+    // Let another thread stop generatePuzzle: the flag is checked between attempts and
+    // between removals, and generatePuzzle returns false (leaving a partly dug board)
+    // once it is set. nullptr detaches.
+    void setCancelFlag(const std::atomic<bool>* flag);
+
+    // Have generatePuzzle store how far it is, 0-100: the cells dug so far as a share of
+    // MAX_GRADING_ATTEMPTS full attempts, so it never goes back, then 100 when it
+    // returns (usually early, on an attempt that meets the target). nullptr detaches.
+    void setProgress(std::atomic<int>* percent);
+
+    // Search counters of the last top-level call; the overloads above also return them.
+    // All zero unless built with SUDOKU_SOLVER_STATS.
+    const SolverStats& getLastStats() const;
+
+    // Rating and techniques needed for the last generated puzzle (9x9 only; larger
+    // puzzles report the target rating and no techniques)
+    LogicSolver::Rating getPuzzleRating() const;
+    unsigned int getPuzzleTechniques() const;
     
     // Get a hint (returns a valid move)
     std::pair<int, int> getHint();
 };
 
+// Classic 9x9 solver
+typedef BasicSudokuSolver<3> SudokuSolver;
+
+// Larger grids
+typedef BasicSudokuSolver<4> SudokuSolver16;
+typedef BasicSudokuSolver<5> SudokuSolver25;
+
 #endif //SUDOKUSOLVER_H
@@ -0,0 +1,27 @@
+# Sudoku engine shared by the Qt game and the command-line tools.
+# Depends only on the C++ standard library (no Qt modules).
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/SudokuBoard.cpp \
+    $$PWD/SudokuSolver.cpp \
+    $$PWD/DancingLinks.cpp \
+    $$PWD/CandidateKernel.cpp \
+    $$PWD/LogicSolver.cpp \
+    $$PWD/PuzzlePool.cpp \
+    $$PWD/PuzzleBank.cpp \
+    $$PWD/BoardCodec.cpp \
+    $$files($$PWD/data-structures/*.cpp)
+
+HEADERS += \
+    $$PWD/sudokuboard.h \
+    $$PWD/SudokuSolver.h \
+    $$PWD/SolverStats.h \
+    $$PWD/DancingLinks.h \
+    $$PWD/CandidateKernel.h \
+    $$PWD/LogicSolver.h \
+    $$PWD/PuzzlePool.h \
+    $$PWD/PuzzleBank.h \
+    $$PWD/BoardCodec.h \
+    $$files($$PWD/data-structures/*.h)
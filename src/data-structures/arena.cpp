@@ -0,0 +1,78 @@
+#include "arena.h"
+#include <cstdint>
+#include <new>
+
+Arena::Arena(size_t blockSize)
+    : first(nullptr), current(nullptr), cursor(nullptr), limit(nullptr),
+      blockSize(blockSize), used(0), reserved(0), resetCount(0) {
+}
+
+Arena::~Arena() {
+    Block* block = first;
+    while (block) {
+        Block* next = block->next;
+        ::operator delete(block);
+        block = next;
+    }
+}
+
+char* Arena::blockData(Block* block) {
+    return reinterpret_cast<char*>(block) + sizeof(Block);
+}
+
+// Move to a block with at least minSize free bytes, reusing blocks kept by reset()
+void Arena::nextBlock(size_t minSize) {
+    Block* next = current ? current->next : first;
+    if (next == nullptr || next->size < minSize) {
+        size_t size = minSize > blockSize ? minSize : blockSize;
+        Block* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+        block->size = size;
+        block->next = next;
+        if (current) {
+            current->next = block;
+        } else {
+            first = block;
+        }
+        reserved += size;
+        next = block;
+    }
+
+    current = next;
+    cursor = blockData(current);
+    limit = cursor + current->size;
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(cursor);
+    uintptr_t aligned = (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    if (cursor == nullptr || aligned + size > reinterpret_cast<uintptr_t>(limit)) {
+        // Blocks start max-aligned; the extra bytes cover stricter alignments
+        nextBlock(size + alignment);
+        address = reinterpret_cast<uintptr_t>(cursor);
+        aligned = (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    }
+
+    cursor = reinterpret_cast<char*>(aligned + size);
+    used += size;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void Arena::reset() {
+    current = nullptr;
+    cursor = nullptr;
+    limit = nullptr;
+    used = 0;
+    resetCount++;
+}
+
+size_t Arena::bytesUsed() const {
+    return used;
+}
+
+size_t Arena::bytesReserved() const {
+    return reserved;
+}
+
+unsigned int Arena::generation() const {
+    return resetCount;
+}
@@ -0,0 +1,57 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+
+// Bump-pointer allocator for short-lived scratch memory. Allocations are carved out of
+// large blocks and never freed one by one; reset() releases everything at once by
+// rewinding to the first block, and keeps the blocks for reuse.
+//
+// Every reset() bumps generation(), so a container holding arena memory can tell that
+// its storage is gone and drop it without touching it.
+class Arena {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit Arena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Uninitialized memory, valid until the next reset()
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Uninitialized storage for count objects of type T
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Release every allocation
+    void reset();
+
+    size_t bytesUsed() const;
+    size_t bytesReserved() const;
+    unsigned int generation() const;
+
+private:
+    struct Block {
+        Block* next;
+        size_t size;  // Usable bytes after the header
+    };
+
+    Block* first;
+    Block* current;
+    char* cursor;
+    char* limit;
+    size_t blockSize;
+    size_t used;
+    size_t reserved;
+    unsigned int resetCount;
+
+    static char* blockData(Block* block);
+    void nextBlock(size_t minSize);
+};
+
+#endif // ARENA_H
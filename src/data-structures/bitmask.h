@@ -0,0 +1,83 @@
+#ifndef BITMASK_H
+#define BITMASK_H
+
+#include "unorderedSet.h"
+
+// Candidate masks store value v (1-based) in bit (v - 1)
+
+// Bit for a single value
+inline unsigned int maskBit(int value) {
+    return 1u << (value - 1);
+}
+
+// Mask holding every value from 1 to maxValue
+inline unsigned int fullMask(int maxValue) {
+    return (1u << maxValue) - 1u;
+}
+
+// Bit for a single value in a mask of any width (16, 32 or 64 bits)
+template <typename Mask>
+inline Mask maskBitOf(int value) {
+    return static_cast<Mask>(static_cast<Mask>(1) << (value - 1));
+}
+
+// Number of values in a mask
+template <typename Mask>
+inline int countBits(Mask mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    if (sizeof(Mask) > sizeof(unsigned int)) {
+        return __builtin_popcountll(mask);
+    }
+    return __builtin_popcount(static_cast<unsigned int>(mask));
+#else
+    int count = 0;
+    while (mask) {
+        mask &= mask - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// Smallest value in a mask (0 if the mask is empty)
+template <typename Mask>
+inline int lowestValue(Mask mask) {
+    if (mask == 0) {
+        return 0;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    if (sizeof(Mask) > sizeof(unsigned int)) {
+        return __builtin_ctzll(mask) + 1;
+    }
+    return __builtin_ctz(static_cast<unsigned int>(mask)) + 1;
+#else
+    int value = 1;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        value++;
+    }
+    return value;
+#endif
+}
+
+// Compatibility adapters for code that still works with unorderedSet domains
+inline unorderedSet maskToSet(unsigned int mask) {
+    unorderedSet values;
+    while (mask) {
+        values.insert(lowestValue(mask));
+        mask &= mask - 1;
+    }
+    return values;
+}
+
+inline unsigned int setToMask(const unorderedSet& values) {
+    unsigned int mask = 0;
+    for (int value : values) {
+        if (value >= 1 && value <= 32) {
+            mask |= maskBit(value);
+        }
+    }
+    return mask;
+}
+
+#endif // BITMASK_H
@@ -1,34 +1,271 @@
 #ifndef CUSTOM_VECTOR_H
 #define CUSTOM_VECTOR_H
 
-template <typename T>
+#include "arena.h"
+#include <new>
+#include <utility>
+
+// Growable array with inline storage for the first InlineCapacity elements (sized for
+// a cell's 20 peers), so short vectors never touch the heap. Elements live in raw
+// storage and are only constructed when added; growth moves them into the new block.
+// Header-only so every call can be inlined.
+//
+// Blocks beyond the inline buffer come from the heap, or from an Arena passed to the
+// constructor (copies share it). Arena blocks are never freed by the vector, and once
+// the arena is reset the vector must be cleared before reuse; clear() then just forgets
+// the old elements.
+template <typename T, int InlineCapacity = 20>
 class CustomVector {
+    static_assert(InlineCapacity > 0, "CustomVector needs at least one inline slot");
+
 private:
-    T* data;
-    int capacity;
+    T* elements;         // Inline buffer or heap block
+    int storageCapacity;
     int currentSize;
+    Arena* arena;                  // nullptr for heap blocks
+    unsigned int arenaGeneration;  // Arena generation the current block came from
+    alignas(T) unsigned char inlineBuffer[InlineCapacity * sizeof(T)];
+
+    T* inlineElements() {
+        return reinterpret_cast<T*>(inlineBuffer);
+    }
+
+    bool isInline() const {
+        return elements == reinterpret_cast<const T*>(inlineBuffer);
+    }
+
+    // Move the elements into a heap block of at least minCapacity slots
+    void grow(int minCapacity) {
+        int newCapacity = storageCapacity * 2;
+        if (newCapacity < minCapacity) {
+            newCapacity = minCapacity;
+        }
+
+        T* newElements;
+        if (arena != nullptr) {
+            newElements = arena->allocateArray<T>(newCapacity);
+            arenaGeneration = arena->generation();
+        } else {
+            newElements = static_cast<T*>(::operator new(sizeof(T) * newCapacity));
+        }
+        for (int i = 0; i < currentSize; i++) {
+            new (newElements + i) T(std::move(elements[i]));
+            elements[i].~T();
+        }
+        releaseHeap();
+        elements = newElements;
+        storageCapacity = newCapacity;
+    }
+
+    void destroyAll() {
+        for (int i = 0; i < currentSize; i++) {
+            elements[i].~T();
+        }
+        currentSize = 0;
+    }
+
+    void releaseHeap() {
+        if (!isInline() && arena == nullptr) {
+            ::operator delete(elements);
+        }
+    }
+
+    // True once the arena holding the block has been reset
+    bool storageLost() const {
+        return arena != nullptr && !isInline() && arena->generation() != arenaGeneration;
+    }
 
-    void resize();
+    void resetToInline() {
+        elements = inlineElements();
+        storageCapacity = InlineCapacity;
+        currentSize = 0;
+    }
+
+    // Take other's elements, leaving it empty
+    void moveFrom(CustomVector& other) {
+        if (other.isInline()) {
+            resetToInline();
+            for (int i = 0; i < other.currentSize; i++) {
+                new (elements + i) T(std::move(other.elements[i]));
+            }
+            currentSize = other.currentSize;
+            other.destroyAll();
+        } else {
+            elements = other.elements;
+            storageCapacity = other.storageCapacity;
+            currentSize = other.currentSize;
+            arenaGeneration = other.arenaGeneration;
+            other.resetToInline();
+        }
+    }
 
 public:
-    CustomVector();
-    CustomVector(int initialCapacity);
-    CustomVector(const CustomVector<T>& other);
-    ~CustomVector();
-    
-    CustomVector<T>& operator=(const CustomVector<T>& other);
-    
-    T& operator[](int index);
-    const T& operator[](int index) const;
-    T& at(int index);
-    const T& at(int index) const;
-    
-    int size() const;
-    bool empty() const;
-    
-    void push_back(const T& value);
-    void pop_back();
-    void clear();
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    CustomVector() : arena(nullptr), arenaGeneration(0) {
+        resetToInline();
+    }
+
+    CustomVector(int initialCapacity) : arena(nullptr), arenaGeneration(0) {
+        resetToInline();
+        reserve(initialCapacity);
+    }
+
+    // Vector whose blocks beyond the inline buffer are allocated from storageArena
+    explicit CustomVector(Arena* storageArena, int initialCapacity = 0)
+        : arena(storageArena), arenaGeneration(0) {
+        resetToInline();
+        reserve(initialCapacity);
+    }
+
+    CustomVector(const CustomVector& other) : arena(other.arena), arenaGeneration(0) {
+        resetToInline();
+        reserve(other.currentSize);
+        for (int i = 0; i < other.currentSize; i++) {
+            new (elements + i) T(other.elements[i]);
+        }
+        currentSize = other.currentSize;
+    }
+
+    CustomVector(CustomVector&& other) noexcept : arena(other.arena), arenaGeneration(0) {
+        moveFrom(other);
+    }
+
+    ~CustomVector() {
+        if (!storageLost()) {
+            destroyAll();
+            releaseHeap();
+        }
+    }
+
+    CustomVector& operator=(const CustomVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.currentSize);
+            for (int i = 0; i < other.currentSize; i++) {
+                new (elements + i) T(other.elements[i]);
+            }
+            currentSize = other.currentSize;
+        }
+        return *this;
+    }
+
+    CustomVector& operator=(CustomVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            releaseHeap();
+            arena = other.arena;
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    // Element access without bounds checking
+    T& operator[](int index) {
+        return elements[index];
+    }
+
+    const T& operator[](int index) const {
+        return elements[index];
+    }
+
+    // Element access with bounds checking
+    T& at(int index) {
+        if (index < 0 || index >= currentSize) {
+            throw "Index out of range";
+        }
+        return elements[index];
+    }
+
+    const T& at(int index) const {
+        if (index < 0 || index >= currentSize) {
+            throw "Index out of range";
+        }
+        return elements[index];
+    }
+
+    int size() const {
+        return currentSize;
+    }
+
+    int capacity() const {
+        return storageCapacity;
+    }
+
+    bool empty() const {
+        return currentSize == 0;
+    }
+
+    // Make room for at least newCapacity elements
+    void reserve(int newCapacity) {
+        if (newCapacity > storageCapacity) {
+            grow(newCapacity);
+        }
+    }
+
+    void push_back(const T& value) {
+        if (currentSize >= storageCapacity) {
+            // value may live in this vector; copy it before the elements move
+            T copy(value);
+            grow(currentSize + 1);
+            new (elements + currentSize) T(std::move(copy));
+        } else {
+            new (elements + currentSize) T(value);
+        }
+        currentSize++;
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    // Construct an element in place at the end
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (currentSize >= storageCapacity) {
+            T value(std::forward<Args>(args)...);
+            grow(currentSize + 1);
+            new (elements + currentSize) T(std::move(value));
+        } else {
+            new (elements + currentSize) T(std::forward<Args>(args)...);
+        }
+        return elements[currentSize++];
+    }
+
+    // Remove the last element
+    void pop_back() {
+        if (currentSize > 0) {
+            currentSize--;
+            elements[currentSize].~T();
+        }
+    }
+
+    // Remove all elements (keeps the capacity unless the arena was reset)
+    void clear() {
+        if (storageLost()) {
+            resetToInline();
+            return;
+        }
+        destroyAll();
+    }
+
+    // Range-for support
+    iterator begin() {
+        return elements;
+    }
+
+    iterator end() {
+        return elements + currentSize;
+    }
+
+    const_iterator begin() const {
+        return elements;
+    }
+
+    const_iterator end() const {
+        return elements + currentSize;
+    }
 };
 
 #endif // CUSTOM_VECTOR_H
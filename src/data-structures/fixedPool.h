@@ -0,0 +1,55 @@
+#ifndef FIXEDPOOL_H
+#define FIXEDPOOL_H
+
+#include "arena.h"
+
+// Free-list allocator for objects of one type. Slots come from an internal arena and
+// freed slots are pushed on a free list for reuse, so allocate() and deallocate() are
+// a few pointer moves. reset() drops every slot at once.
+template <typename T>
+class FixedPool {
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    Arena arena;
+    Slot* freeList;
+
+public:
+    explicit FixedPool(size_t blockSize = Arena::DEFAULT_BLOCK_SIZE) : arena(blockSize), freeList(nullptr) {
+    }
+
+    FixedPool(const FixedPool&) = delete;
+    FixedPool& operator=(const FixedPool&) = delete;
+
+    // Uninitialized storage for one T
+    void* allocate() {
+        if (freeList != nullptr) {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            return slot;
+        }
+        return arena.allocate(sizeof(Slot), alignof(Slot));
+    }
+
+    // Return storage from allocate(); the object must already be destroyed
+    void deallocate(void* memory) {
+        Slot* slot = static_cast<Slot*>(memory);
+        slot->next = freeList;
+        freeList = slot;
+    }
+
+    // Release every slot, allocated or free
+    void reset() {
+        freeList = nullptr;
+        arena.reset();
+    }
+
+    unsigned int generation() const {
+        return arena.generation();
+    }
+};
+
+#endif // FIXEDPOOL_H
@@ -1,154 +1,121 @@
-#include "Graph.h"
+#include "graph.h"
+#include <cstring>
 #include <iostream>
+#include <type_traits>
 
-// Vertex constructor implementation
-Graph::Vertex::Vertex(int r, int c) : row(r), col(c) {
-    // Initialize domain with all possible values 1-9
-    for (int i = 1; i <= 9; i++) {
-        domain.insert(i);
-    }
-}
+static_assert(std::is_trivially_copyable<Graph>::value, "Graph must copy with a memcpy");
+static_assert(sizeof(Graph::Mask) == 2, "9x9 domains are 16-bit masks");
 
 // Graph constructor
-Graph::Graph() : numVertices(0) {
+template <int BoxSize>
+BasicGraph<BoxSize>::BasicGraph() : numVertices(0) {
     for (int i = 0; i < MAX_VERTICES; i++) {
         vertexExists[i] = false;
-        vertices[i] = nullptr;
-    }
-}
-
-// Graph destructor
-Graph::~Graph() {
-    for (int i = 0; i < MAX_VERTICES; i++) {
-        if (vertexExists[i]) {
-            delete vertices[i];
-        }
+        domains[i] = 0;
     }
 }
 
 // Convert row, col to a unique vertex ID
-int Graph::getVertexId(int row, int col) const {
-    return row * 9 + col;
+template <int BoxSize>
+int BasicGraph<BoxSize>::getVertexId(int row, int col) const {
+    return row * SIZE + col;
 }
 
 // Add a vertex to the graph
-void Graph::addVertex(int row, int col) {
+template <int BoxSize>
+void BasicGraph<BoxSize>::addVertex(int row, int col) {
     int id = getVertexId(row, col);
     if (!vertexExists[id]) {
-        vertices[id] = new Vertex(row, col);
+        // Initialize domain with all possible values
+        domains[id] = Geometry::ALL_VALUES;
         vertexExists[id] = true;
         numVertices++;
     }
 }
 
-// Add an edge between two vertices
-void Graph::addEdge(int row1, int col1, int row2, int col2) {
-    int id1 = getVertexId(row1, col1);
-    int id2 = getVertexId(row2, col2);
-    
-    // Don't add self-loops
-    if (id1 == id2) return;
-    
-    if (vertexExists[id1] && vertexExists[id2]) {
-        // Check if the edge already exists
-        CustomVector<CustomPair<int, int>>& neighbors = vertices[id1]->neighbors;
-        bool edgeExists = false;
-        
-        for (int i = 0; i < neighbors.size(); i++) {
-            if (neighbors[i].first == row2 && neighbors[i].second == col2) {
-                edgeExists = true;
-                break;
-            }
-        }
-        
-        if (!edgeExists) {
-            vertices[id1]->neighbors.push_back(CustomPair<int, int>(row2, col2));
-        }
-        
-        // Add the reverse edge
-        neighbors = vertices[id2]->neighbors;
-        edgeExists = false;
-        
-        for (int i = 0; i < neighbors.size(); i++) {
-            if (neighbors[i].first == row1 && neighbors[i].second == col1) {
-                edgeExists = true;
-                break;
-            }
-        }
-        
-        if (!edgeExists) {
-            vertices[id2]->neighbors.push_back(CustomPair<int, int>(row1, col1));
-        }
-    }
-}
-
 // Get neighbors of a vertex
-CustomVector<CustomPair<int, int>> Graph::getNeighbors(int row, int col) const {
+template <int BoxSize>
+typename BasicGraph<BoxSize>::Span BasicGraph<BoxSize>::getNeighbors(int row, int col) const {
     int id = getVertexId(row, col);
     if (vertexExists[id]) {
-        return vertices[id]->neighbors;
+        return peersOf<BoxSize>(id);
     }
-    return CustomVector<CustomPair<int, int>>();
+    return Span(nullptr, 0);
 }
-void Graph::debugPrint() const {
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
+
+template <int BoxSize>
+void BasicGraph<BoxSize>::debugPrint() const {
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
             int id = getVertexId(row, col);
             if (vertexExists[id]) {
                 std::cout << "Cell (" << row << ", " << col << ") domain: { ";
-                for (auto it = vertices[id]->domain.begin(); it != vertices[id]->domain.end(); ++it) {
-                    std::cout << *it << " ";
+                for (int value = 1; value <= MAX_VALUE; value++) {
+                    if (domains[id] & maskBitOf<Mask>(value)) {
+                        std::cout << value << " ";
+                    }
                 }
                 std::cout << "} | Neighbors: ";
-                for (int i = 0; i < vertices[id]->neighbors.size(); i++) {
-                    std::cout << "(" << vertices[id]->neighbors[i].first << "," << vertices[id]->neighbors[i].second << ") ";
+                for (int peer : peersOf<BoxSize>(id)) {
+                    std::cout << "(" << peer / SIZE << "," << peer % SIZE << ") ";
                 }
                 std::cout << "\n";
             }
         }
     }
 }
-void Graph::connectSudokuConstraints() {
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
-            // Connect all other cells in same row
-            for (int k = 0; k < 9; k++) {
-                if (k != col) addEdge(row, col, row, k);
-            }
-            // Connect all other cells in same column
-            for (int k = 0; k < 9; k++) {
-                if (k != row) addEdge(row, col, k, col);
-            }
-            // Connect all other cells in the same 3x3 box
-            int boxRowStart = (row / 3) * 3;
-            int boxColStart = (col / 3) * 3;
-            for (int r = boxRowStart; r < boxRowStart + 3; r++) {
-                for (int c = boxColStart; c < boxColStart + 3; c++) {
-                    if (r != row || c != col) {
-                        addEdge(row, col, r, c);
-                    }
-                }
-            }
-        }
+
+// Set the domain of a vertex
+template <int BoxSize>
+bool BasicGraph<BoxSize>::setDomain(int row, int col, const unorderedSet& domain) {
+    return setDomainMask(row, col, static_cast<Mask>(setToMask(domain) & Geometry::ALL_VALUES));
+}
+
+// Get the domain of a vertex as a set
+template <int BoxSize>
+unorderedSet BasicGraph<BoxSize>::getDomain(int row, int col) const {
+    return maskToSet(getDomainMask(row, col));
+}
+
+// Get the domain of a vertex as a bitmask
+template <int BoxSize>
+typename BasicGraph<BoxSize>::Mask BasicGraph<BoxSize>::getDomainMask(int row, int col) const {
+    int id = getVertexId(row, col);
+    if (vertexExists[id]) {
+        return domains[id];
     }
+    return 0;
 }
 
-// Set the domain of a vertex
-bool Graph::setDomain(int row, int col, const unorderedSet& domain) {
+// Copy all domain masks out in one block
+template <int BoxSize>
+void BasicGraph<BoxSize>::getDomainMasks(Mask masks[MAX_VERTICES]) const {
+    std::memcpy(masks, domains, sizeof(domains));
+}
+
+// Replace all domain masks in one block
+template <int BoxSize>
+void BasicGraph<BoxSize>::setDomainMasks(const Mask masks[MAX_VERTICES]) {
+    std::memcpy(domains, masks, sizeof(domains));
+}
+
+// Set the domain of a vertex from a bitmask
+template <int BoxSize>
+bool BasicGraph<BoxSize>::setDomainMask(int row, int col, Mask mask) {
     int id = getVertexId(row, col);
     if (vertexExists[id]) {
-        vertices[id]->domain = domain;
+        domains[id] = mask;
         return true;
     }
     return false;
 }
 
 // Set a single value in the domain
-bool Graph::setValue(int row, int col, int value) {
+template <int BoxSize>
+bool BasicGraph<BoxSize>::setValue(int row, int col, int value) {
     int id = getVertexId(row, col);
     if (vertexExists[id]) {
-        vertices[id]->domain.clear();
-        vertices[id]->domain.insert(value);
+        domains[id] = maskBitOf<Mask>(value);
         return true;
     }
     return false;
@@ -156,41 +123,47 @@ bool Graph::setValue(int row, int col, int value) {
 
 
 // Remove a value from the domain of a vertex
-bool Graph::removeFromDomain(int row, int col, int value) {
+template <int BoxSize>
+bool BasicGraph<BoxSize>::removeFromDomain(int row, int col, int value) {
     int id = getVertexId(row, col);
     if (vertexExists[id]) {
-        vertices[id]->domain.remove(value);
+        domains[id] &= static_cast<Mask>(~maskBitOf<Mask>(value));
         return true;
     }
     return false;
 }
 
 // Check if a vertex has a single value in its domain
-bool Graph::isSingleValue(int row, int col) const {
+template <int BoxSize>
+bool BasicGraph<BoxSize>::isSingleValue(int row, int col) const {
     int id = getVertexId(row, col);
     if (vertexExists[id]) {
-        return vertices[id]->domain.size() == 1;
+        return countBits(domains[id]) == 1;
     }
     return false;
 }
 
 // Get the single value in the domain if it has only one value
-int Graph::getValue(int row, int col) const {
+template <int BoxSize>
+int BasicGraph<BoxSize>::getValue(int row, int col) const {
     int id = getVertexId(row, col);
-    if (vertexExists[id] && vertices[id]->domain.size() == 1) {
-        // Since we can't directly access the first element of our custom set,
-        // we'll use the iterator to get the first element
-        unorderedSet::Iterator it = vertices[id]->domain.begin();
-        return *it;
+    if (vertexExists[id] && countBits(domains[id]) == 1) {
+        return lowestValue(domains[id]);
     }
     return 0; // Return 0 if not single value or invalid
 }
 
 // Check if the domain is empty
-bool Graph::isDomainEmpty(int row, int col) const {
+template <int BoxSize>
+bool BasicGraph<BoxSize>::isDomainEmpty(int row, int col) const {
     int id = getVertexId(row, col);
     if (vertexExists[id]) {
-        return vertices[id]->domain.empty();
+        return domains[id] == 0;
     }
     return true; // Consider invalid vertices as having empty domains
 }
+
+// 9x9, 16x16 and 25x25
+template class BasicGraph<3>;
+template class BasicGraph<4>;
+template class BasicGraph<5>;
@@ -2,23 +2,30 @@
 #define GRAPH_H
 
 #include "unorderedSet.h"
-#include "CustomVector.h"
-#include "CustomPair.h"
+#include "bitmask.h"
+#include "peerTable.h"
+
+// Constraint graph of a Sudoku with BoxSize x BoxSize boxes: one vertex per cell, edges
+// between peers.
+//
+// Stored as plain arrays: the vertex domains are one contiguous array of candidate
+// masks (16, 32 or 64 bits wide, see BoardGeometry), and the adjacency is the shared
+// compile-time table in compressed sparse row form (peerTable.h). A graph never
+// allocates and is trivially copyable, so copying a board copies its graph with a memcpy.
+template <int BoxSize>
+class BasicGraph {
+public:
+    typedef BoardGeometry<BoxSize> Geometry;
+    typedef typename Geometry::Mask Mask;
+    typedef BasicNeighborSpan<typename Geometry::CellId> Span;
 
-class Graph {
 private:
-    // Each cell in the Sudoku is a vertex in our graph
-    struct Vertex {
-        int row, col;  // Position in the Sudoku board
-        unorderedSet domain;  // Possible values for this cell
-        CustomVector<CustomPair<int, int>> neighbors;  // Adjacent vertices
-        
-        Vertex(int r, int c);
-    };
-    
-    // Custom map implementation for vertices
-    static const int MAX_VERTICES = 81; // 9x9 board
-    Vertex* vertices[MAX_VERTICES];
+    static const int SIZE = Geometry::SIZE;
+    static const int MAX_VERTICES = Geometry::CELLS;
+    static const int MAX_VALUE = Geometry::SIZE;  // Values range over 1..MAX_VALUE
+
+    // Possible values of each cell (bit v-1 set when v is allowed), indexed by vertex id
+    Mask domains[MAX_VERTICES];
     bool vertexExists[MAX_VERTICES];
     int numVertices;
     
@@ -26,19 +33,16 @@ private:
     int getVertexId(int row, int col) const;
     
 public:
-    Graph();
-    ~Graph();
+    BasicGraph();
     
     // Add a vertex to the graph
     void addVertex(int row, int col);
     
-    // Add an edge between two vertices
-    void addEdge(int row1, int col1, int row2, int col2);
     void debugPrint() const; // For debugging purposes
-    void connectSudokuConstraints(); // Connect all constraints in Sudoku
     
-    // Get neighbors of a vertex
-    CustomVector<CustomPair<int, int>> getNeighbors(int row, int col) const;
+    // Get neighbors of a vertex: the cells (row * SIZE + col) sharing its row, column or
+    // box. Edges are fixed by the Sudoku rules and come from the compile-time peer table.
+    Span getNeighbors(int row, int col) const;
     
     // Set the domain of a vertex (possible values for a cell)
     bool setDomain(int row, int col, const unorderedSet& domain);
@@ -48,6 +52,14 @@ public:
     
     // Get the domain of a vertex
     unorderedSet getDomain(int row, int col) const;
+
+    // Bitmask access to the domain (no allocation)
+    Mask getDomainMask(int row, int col) const;
+    bool setDomainMask(int row, int col, Mask mask);
+
+    // Copy all domain masks at once (indexed by vertex id)
+    void getDomainMasks(Mask masks[MAX_VERTICES]) const;
+    void setDomainMasks(const Mask masks[MAX_VERTICES]);
     
     // Remove a value from the domain of a vertex
     bool removeFromDomain(int row, int col, int value);
@@ -62,4 +74,7 @@ public:
     bool isDomainEmpty(int row, int col) const;
 };
 
+// Classic 9x9 graph
+typedef BasicGraph<3> Graph;
+
 #endif // GRAPH_H
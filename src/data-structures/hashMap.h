@@ -0,0 +1,390 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include "customPair.h"
+#include "arena.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+
+// Spread the bits of a hash so that the low bits used as the slot index depend on
+// all of them (std::hash of an integer is the integer itself)
+inline size_t mixHash(size_t hash) {
+    uint64_t x = static_cast<uint64_t>(hash);
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<size_t>(x);
+}
+
+// Default hash: std::hash followed by a bit mixer
+template <typename K>
+struct DefaultHash {
+    size_t operator()(const K& key) const {
+        return mixHash(std::hash<K>()(key));
+    }
+};
+
+// Open-addressing hash map with Robin Hood probing.
+//
+// Entries live in one contiguous array whose size is a power of two; a parallel array
+// holds each slot's probe length (distance from its home slot + 1, 0 for empty). On
+// insert an entry takes the slot of any entry closer to its home, which keeps probe
+// sequences short and lets a lookup stop as soon as it meets such an entry. Removal
+// shifts the following entries back one slot instead of leaving tombstones. The table
+// doubles once it is 7/8 full.
+//
+// Storage comes from the heap, or from an Arena passed to the constructor (copies share
+// it). Arena storage is never freed by the map, and once the arena is reset the map must
+// be cleared before reuse; clear() then just forgets the old table.
+template <typename K, typename V, typename Hash = DefaultHash<K>>
+class HashMap {
+public:
+    typedef CustomPair<K, V> Entry;
+
+private:
+    static const size_t MIN_CAPACITY = 16;
+
+    Entry* entries;              // Raw storage; only occupied slots hold constructed entries
+    unsigned int* probeLengths;  // 0 for an empty slot
+    size_t capacity;             // Power of two (0 before the first insert)
+    size_t mask;
+    size_t count;
+    Arena* arena;                // nullptr for heap storage
+    unsigned int arenaGeneration;
+    Hash hasher;
+
+    size_t homeSlot(const K& key) const {
+        return hasher(key) & mask;
+    }
+
+    // Slot holding key, or capacity if absent
+    size_t findSlot(const K& key) const {
+        if (count == 0) {
+            return capacity;
+        }
+        size_t index = homeSlot(key);
+        for (unsigned int distance = 1; probeLengths[index] >= distance; distance++) {
+            if (entries[index].first == key) {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+        return capacity;
+    }
+
+    // Place an entry known to be absent, displacing entries closer to their home slot
+    Entry& place(Entry&& entry, size_t index, unsigned int distance) {
+        Entry* placed = nullptr;
+        while (probeLengths[index] != 0) {
+            if (probeLengths[index] < distance) {
+                std::swap(entry, entries[index]);
+                std::swap(distance, probeLengths[index]);
+                if (placed == nullptr) {
+                    placed = &entries[index];
+                }
+            }
+            index = (index + 1) & mask;
+            distance++;
+        }
+        new (&entries[index]) Entry(std::move(entry));
+        probeLengths[index] = distance;
+        count++;
+        return placed != nullptr ? *placed : entries[index];
+    }
+
+    void allocate(size_t newCapacity) {
+        if (arena == nullptr) {
+            entries = static_cast<Entry*>(::operator new(sizeof(Entry) * newCapacity));
+            probeLengths = new unsigned int[newCapacity]();
+        } else {
+            entries = arena->allocateArray<Entry>(newCapacity);
+            probeLengths = arena->allocateArray<unsigned int>(newCapacity);
+            std::fill(probeLengths, probeLengths + newCapacity, 0u);
+            arenaGeneration = arena->generation();
+        }
+        capacity = newCapacity;
+        mask = newCapacity - 1;
+        count = 0;
+    }
+
+    void freeStorage(Entry* oldEntries, unsigned int* oldProbeLengths) {
+        if (arena == nullptr) {
+            ::operator delete(oldEntries);
+            delete[] oldProbeLengths;
+        }
+    }
+
+    void dropStorage() {
+        entries = nullptr;
+        probeLengths = nullptr;
+        capacity = 0;
+        mask = 0;
+        count = 0;
+    }
+
+    // True once the arena holding the table has been reset
+    bool storageLost() const {
+        return arena != nullptr && capacity != 0 && arena->generation() != arenaGeneration;
+    }
+
+    void release() {
+        clear();
+        freeStorage(entries, probeLengths);
+        dropStorage();
+    }
+
+    // Move every entry into a table of newCapacity slots
+    void rehash(size_t newCapacity) {
+        Entry* oldEntries = entries;
+        unsigned int* oldProbeLengths = probeLengths;
+        size_t oldCapacity = capacity;
+
+        allocate(newCapacity);
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (oldProbeLengths[i] != 0) {
+                place(std::move(oldEntries[i]), homeSlot(oldEntries[i].first), 1);
+                oldEntries[i].~Entry();
+            }
+        }
+        freeStorage(oldEntries, oldProbeLengths);
+    }
+
+    static bool overLoaded(size_t entryCount, size_t slots) {
+        return entryCount * 8 > slots * 7;
+    }
+
+    // Make room for one more entry
+    void growIfFull() {
+        if (capacity == 0) {
+            allocate(MIN_CAPACITY);
+        } else if (overLoaded(count + 1, capacity)) {
+            rehash(capacity * 2);
+        }
+    }
+
+    void copyFrom(const HashMap& other) {
+        if (other.count == 0) {
+            return;
+        }
+        allocate(other.capacity);
+        for (size_t i = 0; i < other.capacity; i++) {
+            if (other.probeLengths[i] != 0) {
+                new (&entries[i]) Entry(other.entries[i]);
+                probeLengths[i] = other.probeLengths[i];
+            }
+        }
+        count = other.count;
+    }
+
+    void moveFrom(HashMap& other) {
+        entries = other.entries;
+        probeLengths = other.probeLengths;
+        capacity = other.capacity;
+        mask = other.mask;
+        count = other.count;
+        arena = other.arena;
+        arenaGeneration = other.arenaGeneration;
+        other.dropStorage();
+    }
+
+public:
+    // Iterator over the entries, in slot order
+    class Iterator {
+    private:
+        const HashMap* map;
+        size_t index;
+
+        void skipEmpty() {
+            while (index < map->capacity && map->probeLengths[index] == 0) {
+                index++;
+            }
+        }
+
+    public:
+        Iterator(const HashMap* m, size_t start) : map(m), index(start) {
+            skipEmpty();
+        }
+
+        Entry& operator*() const {
+            return map->entries[index];
+        }
+
+        Entry* operator->() const {
+            return &map->entries[index];
+        }
+
+        Iterator& operator++() {
+            index++;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index != other.index;
+        }
+    };
+
+    explicit HashMap(const Hash& hash = Hash())
+        : entries(nullptr), probeLengths(nullptr), capacity(0), mask(0), count(0),
+          arena(nullptr), arenaGeneration(0), hasher(hash) {
+    }
+
+    // Map whose table is allocated from storageArena
+    explicit HashMap(Arena* storageArena, const Hash& hash = Hash())
+        : entries(nullptr), probeLengths(nullptr), capacity(0), mask(0), count(0),
+          arena(storageArena), arenaGeneration(0), hasher(hash) {
+    }
+
+    HashMap(const HashMap& other)
+        : entries(nullptr), probeLengths(nullptr), capacity(0), mask(0), count(0),
+          arena(other.arena), arenaGeneration(0), hasher(other.hasher) {
+        copyFrom(other);
+    }
+
+    HashMap(HashMap&& other) noexcept : hasher(other.hasher) {
+        moveFrom(other);
+    }
+
+    ~HashMap() {
+        release();
+    }
+
+    HashMap& operator=(const HashMap& other) {
+        if (this != &other) {
+            release();
+            arena = other.arena;
+            hasher = other.hasher;
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    HashMap& operator=(HashMap&& other) noexcept {
+        if (this != &other) {
+            release();
+            hasher = other.hasher;
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    // Insert or overwrite; returns true if the key was new
+    bool insert(const K& key, const V& value) {
+        size_t index = findSlot(key);
+        if (index != capacity) {
+            entries[index].second = value;
+            return false;
+        }
+        growIfFull();
+        place(Entry(key, value), homeSlot(key), 1);
+        return true;
+    }
+
+    // Value of key, inserting a default-constructed one if absent
+    V& operator[](const K& key) {
+        size_t index = findSlot(key);
+        if (index != capacity) {
+            return entries[index].second;
+        }
+        growIfFull();
+        return place(Entry(key, V()), homeSlot(key), 1).second;
+    }
+
+    // Pointer to the value of key, or nullptr if absent
+    V* find(const K& key) {
+        size_t index = findSlot(key);
+        return index != capacity ? &entries[index].second : nullptr;
+    }
+
+    const V* find(const K& key) const {
+        size_t index = findSlot(key);
+        return index != capacity ? &entries[index].second : nullptr;
+    }
+
+    bool contains(const K& key) const {
+        return findSlot(key) != capacity;
+    }
+
+    // Remove key; returns false if it was absent
+    bool remove(const K& key) {
+        size_t index = findSlot(key);
+        if (index == capacity) {
+            return false;
+        }
+
+        // Shift the rest of the probe run back one slot
+        entries[index].~Entry();
+        size_t next = (index + 1) & mask;
+        while (probeLengths[next] > 1) {
+            new (&entries[index]) Entry(std::move(entries[next]));
+            entries[next].~Entry();
+            probeLengths[index] = probeLengths[next] - 1;
+            index = next;
+            next = (next + 1) & mask;
+        }
+        probeLengths[index] = 0;
+        count--;
+        return true;
+    }
+
+    // Remove all entries (keeps the table)
+    void clear() {
+        if (storageLost()) {
+            dropStorage();
+            return;
+        }
+        for (size_t i = 0; i < capacity; i++) {
+            if (probeLengths[i] != 0) {
+                entries[i].~Entry();
+                probeLengths[i] = 0;
+            }
+        }
+        count = 0;
+    }
+
+    // Size the table for at least entryCount entries without rehashing
+    void reserve(size_t entryCount) {
+        size_t newCapacity = capacity == 0 ? MIN_CAPACITY : capacity;
+        while (overLoaded(entryCount, newCapacity)) {
+            newCapacity *= 2;
+        }
+        if (capacity == 0) {
+            allocate(newCapacity);
+        } else if (newCapacity > capacity) {
+            rehash(newCapacity);
+        }
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    size_t bucketCount() const {
+        return capacity;
+    }
+
+    double loadFactor() const {
+        return capacity == 0 ? 0.0 : static_cast<double>(count) / capacity;
+    }
+
+    // Iterator support
+    Iterator begin() const {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(this, capacity);
+    }
+};
+
+#endif // HASHMAP_H
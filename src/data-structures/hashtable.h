@@ -1,20 +1,12 @@
 ﻿#ifndef HASHTABLE_H
 #define HASHTABLE_H
 
-#include "customPair.h"
+#include "hashMap.h"
 
+// int -> int map kept for existing callers; backed by the open-addressing HashMap
 class hashtable {
 private:
-    struct node {
-        CustomPair<int, int> data;
-        node* next;
-        node(int key, int value) : data(key, value), next(nullptr) {}
-    };
-
-    static const int table_size = 101;
-    node* table[table_size];
-
-    int hash(int key) const;
+    HashMap<int, int> map;
 
 public:
     hashtable();
@@ -28,5 +20,3 @@ public:
 };
 
 #endif // HASHTABLE_H
-
-
@@ -0,0 +1,119 @@
+#ifndef PEERTABLE_H
+#define PEERTABLE_H
+
+#include <cstdint>
+#include <type_traits>
+
+// Geometry of a Sudoku with BoxSize x BoxSize boxes: 3 for 9x9, 4 for 16x16, 5 for 25x25.
+// Cells are numbered row * SIZE + col.
+template <int BoxSize>
+struct BoardGeometry {
+    static constexpr int BOX = BoxSize;
+    static constexpr int SIZE = BoxSize * BoxSize;  // Rows, columns, boxes and digits
+    static constexpr int CELLS = SIZE * SIZE;
+    static constexpr int PEERS = 3 * SIZE - 2 * BoxSize - 1;  // Row + column + rest of the box
+
+    // Smallest type holding a cell number
+    typedef typename std::conditional<(CELLS <= 256), unsigned char, unsigned short>::type CellId;
+
+    // Candidate mask (bit v-1 for value v): 16, 32 or 64 bits
+    typedef typename std::conditional<(BoxSize <= 3), uint16_t,
+            typename std::conditional<(BoxSize == 4), uint32_t, uint64_t>::type>::type Mask;
+
+    // One bit per peer of a cell
+    typedef typename std::conditional<(PEERS <= 32), uint32_t, uint64_t>::type PeerMask;
+
+    static constexpr Mask ALL_VALUES = static_cast<Mask>((static_cast<uint64_t>(1) << SIZE) - 1);
+
+    static constexpr int boxIndex(int row, int col) {
+        return (row / BoxSize) * BoxSize + col / BoxSize;
+    }
+};
+
+// Peers of every cell, built at compile time: the PEERS distinct other cells that share
+// its row, column or box, in ascending order.
+//
+// The table is in compressed sparse row form: the peers of cell v are
+// neighbors[offsets[v]] .. neighbors[offsets[v + 1] - 1] of one flat array.
+template <int BoxSize>
+struct PeerTable {
+    typedef BoardGeometry<BoxSize> Geometry;
+
+    unsigned short offsets[Geometry::CELLS + 1];
+    typename Geometry::CellId neighbors[Geometry::CELLS * Geometry::PEERS];
+};
+
+// Rows are visited in order and each contributes its peers left to right, so the
+// peers come out sorted without a pass over every other cell
+template <int BoxSize>
+constexpr PeerTable<BoxSize> buildPeerTable() {
+    typedef BoardGeometry<BoxSize> Geometry;
+    typedef typename Geometry::CellId CellId;
+    const int size = Geometry::SIZE;
+
+    PeerTable<BoxSize> table{};
+    int count = 0;
+    for (int cell = 0; cell < Geometry::CELLS; cell++) {
+        int row = cell / size;
+        int col = cell % size;
+        int boxCol = (col / BoxSize) * BoxSize;
+        table.offsets[cell] = static_cast<unsigned short>(count);
+        for (int r = 0; r < size; r++) {
+            if (r == row) {
+                for (int c = 0; c < size; c++) {
+                    if (c != col) {
+                        table.neighbors[count++] = static_cast<CellId>(r * size + c);
+                    }
+                }
+            } else if (r / BoxSize == row / BoxSize) {
+                // Same band: the box columns, which include the cell's own column
+                for (int c = boxCol; c < boxCol + BoxSize; c++) {
+                    table.neighbors[count++] = static_cast<CellId>(r * size + c);
+                }
+            } else {
+                table.neighbors[count++] = static_cast<CellId>(r * size + col);
+            }
+        }
+    }
+    table.offsets[Geometry::CELLS] = static_cast<unsigned short>(count);
+    return table;
+}
+
+template <int BoxSize>
+inline constexpr PeerTable<BoxSize> PEER_TABLE = buildPeerTable<BoxSize>();
+
+static_assert(PEER_TABLE<3>.offsets[81] == 81 * 20, "every 9x9 cell has 20 peers");
+static_assert(PEER_TABLE<3>.neighbors[0] == 1 && PEER_TABLE<3>.neighbors[19] == 72, "peer table layout");
+static_assert(PEER_TABLE<3>.neighbors[PEER_TABLE<3>.offsets[80]] == 8 && PEER_TABLE<3>.neighbors[81 * 20 - 1] == 79,
+              "peer table layout");
+static_assert(PEER_TABLE<4>.offsets[256] == 256 * 39, "every 16x16 cell has 39 peers");
+static_assert(PEER_TABLE<5>.offsets[625] == 625 * 64, "every 25x25 cell has 64 peers");
+
+// Non-owning view of a cell's peers (cell numbers); valid for the whole program
+template <typename CellId>
+class BasicNeighborSpan {
+public:
+    constexpr BasicNeighborSpan(const CellId* cells, int length) : first(cells), count(length) {}
+
+    constexpr int size() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+    constexpr int operator[](int index) const { return first[index]; }
+    constexpr const CellId* begin() const { return first; }
+    constexpr const CellId* end() const { return first + count; }
+
+private:
+    const CellId* first;
+    int count;
+};
+
+typedef BasicNeighborSpan<unsigned char> NeighborSpan;
+
+// Peers of a cell as a span
+template <int BoxSize = 3>
+constexpr BasicNeighborSpan<typename BoardGeometry<BoxSize>::CellId> peersOf(int cell) {
+    return BasicNeighborSpan<typename BoardGeometry<BoxSize>::CellId>(
+        PEER_TABLE<BoxSize>.neighbors + PEER_TABLE<BoxSize>.offsets[cell],
+        PEER_TABLE<BoxSize>.offsets[cell + 1] - PEER_TABLE<BoxSize>.offsets[cell]);
+}
+
+#endif // PEERTABLE_H
@@ -1,33 +1,71 @@
 #include "unorderedSet.h"
+#include <new>
+#include <stdexcept>
 #include <iostream>
 
+// Number of keys in an inline bitset
+static int countKeys(unsigned long long bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(bits);
+#else
+    int count = 0;
+    while (bits != 0) {
+        bits &= bits - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// Smallest key in a non-empty inline bitset
+static int lowestKey(unsigned long long bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int key = 0;
+    while ((bits & 1ULL) == 0) {
+        bits >>= 1;
+        key++;
+    }
+    return key;
+#endif
+}
+
 // Hash function implementation
 int unorderedSet::hashFunction(int key) const {
-    return key % TABLE_SIZE;
+    return static_cast<int>(static_cast<unsigned int>(key) % TABLE_SIZE);
+}
+
+bool unorderedSet::isInline(int key) {
+    return key >= 0 && key < INLINE_KEYS;
 }
 
 // Iterator implementation
 void unorderedSet::Iterator::findNext() {
-    while (currentIndex < TABLE_SIZE) {
+    // Inline keys come first
+    if (remaining != 0 || currentNode != nullptr) {
+        return;
+    }
+
+    if (set->table == nullptr) {
+        currentIndex = TABLE_SIZE;
+        return;
+    }
+
+    // Move to the next non-empty bucket
+    while (++currentIndex < TABLE_SIZE) {
+        currentNode = set->table[currentIndex];
         if (currentNode != nullptr) {
-            return; // Found a valid node
-        }
-        
-        // Move to the next bucket
-        currentIndex++;
-        if (currentIndex < TABLE_SIZE) {
-            currentNode = set->table[currentIndex];
+            return;
         }
     }
 }
 
-unorderedSet::Iterator::Iterator(const unorderedSet* s, bool begin) : set(s), currentIndex(0), currentNode(nullptr) {
+unorderedSet::Iterator::Iterator(const unorderedSet* s, bool begin)
+    : set(s), remaining(0), currentIndex(-1), currentNode(nullptr) {
     if (begin) {
-        // Find the first valid node
-        currentNode = set->table[0];
-        if (currentNode == nullptr) {
-            findNext();
-        }
+        remaining = set->bits;
+        findNext();
     } else {
         // End iterator points past the last bucket
         currentIndex = TABLE_SIZE;
@@ -35,6 +73,9 @@ unorderedSet::Iterator::Iterator(const unorderedSet* s, bool begin) : set(s), cu
 }
 
 int unorderedSet::Iterator::operator*() const {
+    if (remaining != 0) {
+        return lowestKey(remaining);
+    }
     if (currentNode == nullptr) {
         throw std::runtime_error("Dereferencing invalid iterator");
     }
@@ -42,24 +83,27 @@ int unorderedSet::Iterator::operator*() const {
 }
 
 unorderedSet::Iterator& unorderedSet::Iterator::operator++() {
-    if (currentNode != nullptr) {
+    if (remaining != 0) {
+        remaining &= remaining - 1;
+    } else if (currentNode != nullptr) {
         currentNode = currentNode->next;
-        if (currentNode == nullptr) {
-            findNext();
-        }
     }
+    findNext();
     return *this;
 }
 
 bool unorderedSet::Iterator::operator!=(const Iterator& other) const {
-    return currentIndex != other.currentIndex || currentNode != other.currentNode;
+    return remaining != other.remaining || currentIndex != other.currentIndex
+        || currentNode != other.currentNode;
 }
 
 // Constructor
-unorderedSet::unorderedSet() {
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        table[i] = nullptr;
-    }
+unorderedSet::unorderedSet() : bits(0), table(nullptr), overflowCount(0), poolGeneration(0), pool(nullptr) {
+}
+
+// Constructor taking overflow nodes from a pool
+unorderedSet::unorderedSet(NodePool* nodePool)
+    : bits(0), table(nullptr), overflowCount(0), poolGeneration(0), pool(nodePool) {
 }
 
 // Destructor
@@ -67,14 +111,30 @@ unorderedSet::~unorderedSet() {
     clear();
 }
 
-// Copy constructor
-unorderedSet::unorderedSet(const unorderedSet& other) {
-    // Initialize all buckets to nullptr
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        table[i] = nullptr;
+// Copy constructor (the copy shares the other set's pool)
+unorderedSet::unorderedSet(const unorderedSet& other)
+    : bits(other.bits), table(nullptr), overflowCount(0), poolGeneration(0), pool(other.pool) {
+    copyOverflow(other);
+}
+
+// Assignment operator
+unorderedSet& unorderedSet::operator=(const unorderedSet& other) {
+    if (this != &other) {
+        // Clear current contents
+        clear();
+
+        bits = other.bits;
+        copyOverflow(other);
     }
-    
-    // Copy all elements from other
+    return *this;
+}
+
+// Copy the large keys of another set (nothing to do in the common all-inline case)
+void unorderedSet::copyOverflow(const unorderedSet& other) {
+    if (other.table == nullptr) {
+        return;
+    }
+
     for (int i = 0; i < TABLE_SIZE; i++) {
         Node* current = other.table[i];
         while (current) {
@@ -84,28 +144,35 @@ unorderedSet::unorderedSet(const unorderedSet& other) {
     }
 }
 
-// Assignment operator
-unorderedSet& unorderedSet::operator=(const unorderedSet& other) {
-    if (this != &other) {
-        // Clear current contents
-        clear();
-        
-        // Copy all elements from other
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            Node* current = other.table[i];
-            while (current) {
-                insert(current->key);
-                current = current->next;
-            }
-        }
+unorderedSet::Node* unorderedSet::newNode(int key) {
+    if (pool == nullptr) {
+        return new Node(key);
+    }
+    return new (pool->allocate()) Node(key);
+}
+
+void unorderedSet::freeNode(Node* node) {
+    if (pool == nullptr) {
+        delete node;
+    } else {
+        pool->deallocate(node);
     }
-    return *this;
 }
 
 // Insert a key into the set
 void unorderedSet::insert(int key) {
+    if (isInline(key)) {
+        bits |= 1ULL << key;
+        return;
+    }
+
+    if (table == nullptr) {
+        table = new Node*[TABLE_SIZE]();
+        poolGeneration = pool ? pool->generation() : 0;
+    }
+
     int index = hashFunction(key);
-    
+
     // Check if key already exists
     Node* current = table[index];
     while (current) {
@@ -114,15 +181,23 @@ void unorderedSet::insert(int key) {
         }
         current = current->next;
     }
-    
+
     // Insert new key
-    Node* newNode = new Node(key);
-    newNode->next = table[index];
-    table[index] = newNode;
+    Node* node = newNode(key);
+    node->next = table[index];
+    table[index] = node;
+    overflowCount++;
 }
 
 // Check if a key exists in the set
 bool unorderedSet::contains(int key) const {
+    if (isInline(key)) {
+        return (bits >> key) & 1ULL;
+    }
+    if (table == nullptr) {
+        return false;
+    }
+
     int index = hashFunction(key);
     Node* current = table[index];
     while (current) {
@@ -136,6 +211,14 @@ bool unorderedSet::contains(int key) const {
 
 // Remove a key from the set
 void unorderedSet::remove(int key) {
+    if (isInline(key)) {
+        bits &= ~(1ULL << key);
+        return;
+    }
+    if (table == nullptr) {
+        return;
+    }
+
     int index = hashFunction(key);
     Node* current = table[index];
     Node* prev = nullptr;
@@ -146,7 +229,8 @@ void unorderedSet::remove(int key) {
             } else {
                 table[index] = current->next;
             }
-            delete current;
+            freeNode(current);
+            overflowCount--;
             return;
         }
         prev = current;
@@ -156,38 +240,34 @@ void unorderedSet::remove(int key) {
 
 // Clear all elements
 void unorderedSet::clear() {
-    for (int i = 0; i < TABLE_SIZE; i++) {
+    bits = 0;
+    if (table == nullptr) {
+        return;
+    }
+
+    // Nodes of a pool that was reset since are already gone
+    bool nodesLive = pool == nullptr || pool->generation() == poolGeneration;
+    for (int i = 0; nodesLive && i < TABLE_SIZE; i++) {
         Node* current = table[i];
         while (current) {
             Node* temp = current;
             current = current->next;
-            delete temp;
+            freeNode(temp);
         }
-        table[i] = nullptr;
     }
+    delete[] table;
+    table = nullptr;
+    overflowCount = 0;
 }
 
 // Get the number of elements in the set
 int unorderedSet::size() const {
-    int count = 0;
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        Node* current = table[i];
-        while (current) {
-            count++;
-            current = current->next;
-        }
-    }
-    return count;
+    return countKeys(bits) + overflowCount;
 }
 
 // Check if the set is empty
 bool unorderedSet::empty() const {
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        if (table[i] != nullptr) {
-            return false;
-        }
-    }
-    return true;
+    return bits == 0 && overflowCount == 0;
 }
 
 // Get iterator to the beginning
@@ -1,30 +1,55 @@
 #ifndef UNORDEREDSET_H
 #define UNORDEREDSET_H
 
+#include "fixedPool.h"
+
+// Set of ints tuned for small keys: keys 0..63 live in an inline 64-bit bitset, so a set
+// of Sudoku digits never allocates, copies in O(1) and iterates in O(size). Any other
+// key goes to a chained hash table that is only allocated once such a key is inserted.
+//
+// Overflow nodes come from the heap, or from a NodePool passed to the constructor. After
+// the pool is reset, a set using it must be cleared before reuse; clear() then drops
+// the old nodes without visiting them.
 class unorderedSet {
 private:
-    static const int TABLE_SIZE = 1000; // Size of the hash table
+    static const int INLINE_KEYS = 64;  // Keys 0..63 are stored in `bits`
+    static const int TABLE_SIZE = 64;   // Buckets of the overflow table
     struct Node {
         int key;
         Node* next;
         Node(int k) : key(k), next(nullptr) {}
     };
-    Node* table[TABLE_SIZE];
+
+public:
+    typedef FixedPool<Node> NodePool;
+
+private:
+    unsigned long long bits;  // Bit k set if inline key k is present
+    Node** table;             // Overflow buckets (nullptr until a large key is inserted)
+    int overflowCount;        // Keys stored in the overflow table
+    unsigned int poolGeneration;  // Pool generation the overflow nodes belong to
+    NodePool* pool;               // nullptr to allocate nodes with new
 
     // Hash function
     int hashFunction(int key) const;
 
+    static bool isInline(int key);
+    void copyOverflow(const unorderedSet& other);
+    Node* newNode(int key);
+    void freeNode(Node* node);
+
 public:
-    // Iterator for traversing the set
+    // Iterator for traversing the set (inline keys in ascending order, then the rest)
     class Iterator {
     private:
         const unorderedSet* set;
+        unsigned long long remaining;  // Inline keys not yet visited
         int currentIndex;
         Node* currentNode;
-        
+
         // Find the next valid node
         void findNext();
-        
+
     public:
         Iterator(const unorderedSet* s, bool begin);
         int operator*() const;
@@ -33,14 +58,15 @@ public:
     };
 
     unorderedSet();
+    explicit unorderedSet(NodePool* nodePool);
     ~unorderedSet();
-    
+
     // Copy constructor
     unorderedSet(const unorderedSet& other);
-    
+
     // Assignment operator
     unorderedSet& operator=(const unorderedSet& other);
-    
+
     // Basic operations
     void insert(int key);
     bool contains(int key) const;
@@ -48,7 +74,7 @@ public:
     void clear();
     int size() const;
     bool empty() const;
-    
+
     // Iterator support
     Iterator begin() const;
     Iterator end() const;
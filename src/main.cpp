@@ -8,7 +8,9 @@
 #include <QApplication>
 #include <mainwindow.h>
 
-#include "sudokuBoard.h"
+#include "sudokuboard.h"
+#include "PuzzlePool.h"
+#include "PuzzleBank.h"
 #include "data-structures/unorderedSet.h"
 
 using namespace std;
@@ -35,8 +37,18 @@ void startTimer(std::atomic<bool>& running) {
 int main(int argc, char *argv[]) {
 
     QApplication a(argc, argv);
+
+    // New games come from the puzzle bank next to the executable if there is one;
+    // otherwise puzzles are pre-generated in the background
+    QString bankPath = QCoreApplication::applicationDirPath() + "/puzzles.bank";
+    if (!PuzzleBank::shared().open(bankPath.toStdString())) {
+        PuzzlePool::shared().start();
+    }
+
     MainWindow w;
     w.show();
 
-    return a.exec();
+    int result = a.exec();
+    PuzzlePool::shared().stop();
+    return result;
 }
@@ -4,6 +4,7 @@
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
+    , v(nullptr)
     , ui(new Ui::MainWindow)
 {
     ui->setupUi(this);
@@ -14,26 +15,31 @@ MainWindow::~MainWindow()
     delete ui;
 }
 
-void MainWindow::on_EasyButton_clicked()
+void MainWindow::openViewer(int difficulty)
 {
-    v = new viewer(1,this);
+    if (v != nullptr) {
+        v->cancelGeneration();
+        v->deleteLater();
+    }
+    v = new viewer(difficulty,this);
     this->hide();
     v->show();
 }
 
+void MainWindow::on_EasyButton_clicked()
+{
+    openViewer(1);
+}
+
 
 void MainWindow::on_MediumButton_clicked()
 {
-    v = new viewer(2,this);
-    this->hide();
-    v->show();
+    openViewer(2);
 }
 
 
 void MainWindow::on_HardButton_clicked()
 {
-    v = new viewer(3,this);
-    this->hide();
-    v->show();
+    openViewer(3);
 }
 
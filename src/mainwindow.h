@@ -28,5 +28,8 @@ private slots:
 
 private:
     Ui::MainWindow *ui;
+
+    // Show a new game, dropping the previous one (and any puzzle it is still generating)
+    void openViewer(int difficulty);
 };
 #endif // MAINWINDOW_H
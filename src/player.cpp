@@ -3,7 +3,9 @@
 //
 
 #include "player.h"
+#include "PuzzleBank.h"
 #include <iostream>
+#include <random>
 
 player::player()
 {
@@ -26,21 +28,62 @@ bool player::checkwin()
         return false;
     }
     
-    // First check if the board is completely filled
-    for (int row = 0; row < 9; row++) {
-        for (int col = 0; col < 9; col++) {
-            if (board->getValue(row, col) == 0) {
-                return false; // Empty cell found, puzzle not complete
-            }
-        }
+    // Both are O(1): the board counts filled cells and repeated digits as it changes
+    return board->isComplete() && board->isValid();
+}
+
+
+// Game difficulty (1-3) as a solver difficulty level
+SudokuSolver::Difficulty player::solverDifficulty(int difficulty)
+{
+    switch (difficulty) {
+        case 1:
+            return SudokuSolver::EASY;
+        case 2:
+            return SudokuSolver::MEDIUM;
+        case 3:
+            return SudokuSolver::HARD;
+        default:
+            return SudokuSolver::MEDIUM;
     }
+}
 
-    // Then check if it's valid according to Sudoku rules
-    return solver->isValidBoard();
+// Take a puzzle from the bank or the pre-generated pool
+bool player::takeReadyPuzzle(int difficulty, PuzzleGrid& puzzle)
+{
+    SudokuSolver::Difficulty diff = solverDifficulty(difficulty);
+    return PuzzleBank::shared().pickRandom(diff, puzzle)
+        || PuzzlePool::shared().tryPop(diff, puzzle);
 }
 
+// Generate a puzzle on a private board, so nothing is shared with the running game
+bool player::generatePuzzle(int difficulty, SudokuSolver::Strategy strategy, PuzzleGrid& puzzle,
+                            const std::atomic<bool>* cancel, std::atomic<int>* progress)
+{
+    SudokuBoard scratch;
+    SudokuSolver generator(scratch, strategy);
+    generator.setSeed(std::random_device{}());
+    generator.setCancelFlag(cancel);
+    generator.setProgress(progress);
+    if (!generator.generatePuzzle(solverDifficulty(difficulty))) {
+        return false;
+    }
+    scratch.getBoardState(puzzle.cells);
+    return true;
+}
 
 void player::startgame(int difficulty)
+{
+    // Take a ready puzzle, or generate one now
+    PuzzleGrid puzzle;
+    if (!takeReadyPuzzle(difficulty, puzzle)) {
+        solver->generatePuzzle(solverDifficulty(difficulty));
+        solver->getBoard().getBoardState(puzzle.cells);
+    }
+    startgame(difficulty, puzzle);
+}
+
+void player::startgame(int difficulty, const PuzzleGrid& puzzle)
 {
     // Clean up previous game if any
     if (board != nullptr) {
@@ -49,32 +92,8 @@ void player::startgame(int difficulty)
     
     // Create a new board
     board = new SudokuBoard();
-    
-    // Using the SudokuSolver's Difficulty enum seen in the code
-    SudokuSolver::Difficulty diff;
-    switch (difficulty) {
-        case 1:
-            diff = SudokuSolver::EASY;
-            break;
-        case 2:
-            diff = SudokuSolver::MEDIUM;
-            break;
-        case 3:
-            diff = SudokuSolver::HARD;
-            break;
-        default:
-            diff = SudokuSolver::MEDIUM;
-    }
     currentDifficulty = difficulty;
-
-    
-    // Generate a puzzle with the specified difficulty
-    solver->generatePuzzle(diff);
-    
-    // Get the board state and copy it
-    int boardState[9][9];
-    solver->getBoard().getBoardState(boardState);
-    board->loadBoard(boardState);
+    board->loadBoard(puzzle.cells);
     
     // Store the initial board state
     initialBoard = *board;
@@ -229,12 +248,15 @@ std::pair<int, int> player::getHint() {
     int minDomainSize = 10; // More than maximum possible (9)
     std::pair<int, int> bestCell(-1, -1);
 
+    // Candidate masks for the whole board in one pass
+    unsigned short masks[81];
+    board->calculateAllDomainMasks(masks);
+
     // Search for the empty cell with the smallest domain
     for (int row = 0; row < 9; row++) {
         for (int col = 0; col < 9; col++) {
             if (board->isEmpty(row, col)) {
-                unorderedSet domain = board->calculateDomain(row, col);
-                int domainSize = domain.size();
+                int domainSize = countBits(masks[row * 9 + col]);
 
                 // If we find a cell with domain size 1, that's an immediate hint
                 if (domainSize == 1) {
@@ -269,6 +291,14 @@ std::pair<int, int> player::getHint() {
 }
 
 
+void player::setSolverStrategy(SudokuSolver::Strategy strategy) {
+    solver->setStrategy(strategy);
+}
+
+SudokuSolver::Strategy player::getSolverStrategy() const {
+    return solver->getStrategy();
+}
+
 void player::setDifficulty(int difficulty) {
     currentDifficulty = difficulty;
 }
@@ -6,6 +6,8 @@
 #define PLAYER_H
 
 #include "SudokuSolver.h"
+#include "PuzzlePool.h"
+#include <atomic>
 #include <vector>
 #include <chrono>
 // Structure to store move information for undo functionality
@@ -24,6 +26,15 @@ public:
     
     // Game management
     void startgame(int difficulty); // Uses SudokuSolver's difficulty system
+    void startgame(int difficulty, const PuzzleGrid& puzzle);
+
+    // Puzzle from the bank or the pre-generated pool, without generating; GUI thread only
+    static bool takeReadyPuzzle(int difficulty, PuzzleGrid& puzzle);
+
+    // Generate a puzzle with a private solver, so it is safe on a worker thread. Returns
+    // false if cancel was set before it finished; progress gets 0-100 (either may be nullptr).
+    static bool generatePuzzle(int difficulty, SudokuSolver::Strategy strategy, PuzzleGrid& puzzle,
+                               const std::atomic<bool>* cancel, std::atomic<int>* progress);
     void restart();
     bool checkwin();
     void setDifficulty(int difficulty);
@@ -38,6 +49,10 @@ public:
     // Add to player.h
     std::pair<int, int> getHint();
 
+    // Choose the search strategy used to generate and solve puzzles
+    void setSolverStrategy(SudokuSolver::Strategy strategy);
+    SudokuSolver::Strategy getSolverStrategy() const;
+
     
     // Move management
     void move(int row, int col, int value);
@@ -48,6 +63,9 @@ public:
     bool isOriginalCell(int row, int col) const;
     int moveCount = 0;
 private:
+    // Game difficulty (1-3) as a solver difficulty level
+    static SudokuSolver::Difficulty solverDifficulty(int difficulty);
+
     SudokuSolver* solver;
     SudokuBoard* board;
     SudokuBoard initialBoard; // Stores the initial state of the board
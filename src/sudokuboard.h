@@ -3,35 +3,125 @@
 
 #include "data-structures/graph.h"
 #include "data-structures/unorderedSet.h"
+#include "data-structures/bitmask.h"
+
+class PackedBoardView;
+
+// Sudoku board with BoxSize x BoxSize boxes (SIZE = BoxSize * BoxSize rows, columns and
+// digits). Instantiated for 9x9, 16x16 and 25x25 in SudokuBoard.cpp; the classic board
+// is the SudokuBoard alias below. Candidate masks are 16, 32 or 64 bits wide to match.
+template <int BoxSize>
+class BasicSudokuBoard {
+public:
+    typedef BoardGeometry<BoxSize> Geometry;
+    typedef typename Geometry::Mask Mask;
+    typedef BasicGraph<BoxSize> GraphType;
+
+    static const int SIZE = Geometry::SIZE;
+    static const int CELLS = Geometry::CELLS;
+
+    // Mask with every value 1..SIZE set
+    static constexpr Mask ALL_VALUES = Geometry::ALL_VALUES;
 
-class SudokuBoard {
 private:
-    Graph constraintGraph;
+    typedef typename Geometry::PeerMask PeerMask;
 
-    bool fixedCells[9][9]; // To mark fixed (initial) cells
+    // Undo log entry for one insert into an empty cell
+    struct TrailEntry {
+        PeerMask changedPeers;  // Bit i set if the i-th peer lost the value
+        typename Geometry::CellId cell;
+        unsigned char value;
+    };
 
-    // Initialize the constraint graph with all vertices and edges
-    void initializeGraph();
+    GraphType constraintGraph;
+
+    bool fixedCells[SIZE][SIZE]; // To mark fixed (initial) cells
+
+    // Digits already used in each row, column and box (bit v-1 for value v)
+    Mask rowUsed[SIZE];
+    Mask colUsed[SIZE];
+    Mask boxUsed[SIZE];
+
+    // Copies of each digit in each row, column and box ([unit][value - 1]); a used-digit
+    // bit stays set while its count is non-zero
+    unsigned char rowCount[SIZE][SIZE];
+    unsigned char colCount[SIZE][SIZE];
+    unsigned char boxCount[SIZE][SIZE];
+
+    // Copies of a digit beyond the first in a row, column or box, over every unit
+    int conflictCount;
+
+    // Inserts into empty cells since the last reset, oldest first. At most one entry per
+    // cell, so CELLS entries always suffice.
+    TrailEntry trail[CELLS];
+    int trailSize;
+
+    // Number of non-empty cells, updated by every insert, remove and undo
+    int filledCount;
+
+    // Empty every cell's counts: used-digit masks, digit counts, filledCount, conflictCount
+    void resetCounts();
+
+    // Count a digit placed in or cleared from a cell
+    void countPlaced(int row, int col, int value);
+    void countCleared(int row, int col, int value);
+
+    // Index of the box containing a cell
+    static int boxIndex(int row, int col);
 
-    // Add all constraints (edges) to the graph
-    void addConstraints();
+    // Initialize the constraint graph with all vertices
+    void initializeGraph();
 
     // Update the internal board array from the graph
     void updateBoardFromGraph();
 
+    // Recompute the domains of the empty peers of a cell after its value was removed
+    void restorePeerDomains(int row, int col);
+
 public:
-    SudokuBoard();
-    int board[9][9]; // For easy access to the current state
+    // Complete state of a board as one flat block, taken by snapshot() and put back
+    // by restore() with a few memcpys
+    struct Snapshot {
+        int cells[SIZE][SIZE];
+        bool fixedCells[SIZE][SIZE];
+        Mask rowUsed[SIZE];
+        Mask colUsed[SIZE];
+        Mask boxUsed[SIZE];
+        Mask domains[CELLS];
+        unsigned char rowCount[SIZE][SIZE];
+        unsigned char colCount[SIZE][SIZE];
+        unsigned char boxCount[SIZE][SIZE];
+        int filledCount;
+        int conflictCount;
+    };
+
+    BasicSudokuBoard();
+    int board[SIZE][SIZE]; // For easy access to the current state
     // Insert a value into the board
     bool insert(int row, int col, int value);
 
-    // Propagate constraints after setting a value
-    void propagateConstraints(int row, int col, int value);
+    // Propagate constraints after setting a value; returns which peers (bit i for the
+    // i-th entry of getNeighbors) lost the value
+    PeerMask propagateConstraints(int row, int col, int value);
     unorderedSet calculateDomain(int row, int col) const;
 
+    // Values allowed in a cell given its row, column and box (O(1), no allocation)
+    Mask calculateDomainMask(int row, int col) const;
+
+    // Candidate masks of all cells in one pass (filled cells get 0); vectorized for 9x9
+    void calculateAllDomainMasks(Mask masks[CELLS]) const;
+
     // Remove a value from the board (reset cell)
     bool remove(int row, int col);
 
+    // Trail for backtracking: mark() returns the current trail position and undoTo()
+    // takes back, newest first, every insert into an empty cell made since, restoring
+    // exactly the domains each one changed. remove(), an overwriting insert, clear(),
+    // loadBoard(), loadPacked() and restore() reset the trail; undoTo() returns false
+    // for a mark from before such a reset.
+    int mark() const;
+    bool undoTo(int trailMark);
+
     // Recalculate all domains based on the current board state
     void recalculateDomains();
 
@@ -41,29 +131,64 @@ public:
     // Get the domain of a cell
     unorderedSet getDomain(int row, int col) const;
 
+    // Get the domain of a cell as a bitmask
+    Mask getDomainMask(int row, int col) const;
+
     // Print the current state of the board
     void printBoard() const;
 
-    // Load a board from a 2D array
-    void loadBoard(const int inputBoard[9][9]);
+    // Load a board from a 2D array, replacing the whole state. Entries 1..SIZE become
+    // fixed clues, including ones that conflict (see isValid() and conflictingCells()).
+    // Every domain is then built in a single pass.
+    void loadBoard(const int inputBoard[SIZE][SIZE]);
+
+    // Save and restore the complete state (values, fixed cells and domains)
+    Snapshot snapshot() const;
+    void restore(const Snapshot& state);
+
+    // Load the clues of a packed 9x9 puzzle straight from its bitmap; returns false if
+    // the encoding is invalid, two clues conflict (both are still loaded, as with
+    // loadBoard()) or the board is not 9x9
+    bool loadPacked(const PackedBoardView& packed);
 
     // Get the graph for the solver to use
-    const Graph& getGraph() const;
+    const GraphType& getGraph() const;
 
     // Get a modifiable reference to the graph (for the solver)
-    Graph& getGraphRef();
+    GraphType& getGraphRef();
 
     // Get the current board state as a 2D array
-    void getBoardState(int outputBoard[9][9]) const;
+    void getBoardState(int outputBoard[SIZE][SIZE]) const;
 
     // Check if a position is empty
     bool isEmpty(int row, int col) const;
 
     // Check if a cell is fixed (part of the original puzzle)
     bool isFixedCell(int row, int col) const;
-    
+
+    // Number of filled cells (O(1))
+    int filledCells() const;
+
+    // Check if every cell is filled (O(1))
+    bool isComplete() const;
+
+    // Check that no row, column or box repeats a digit (O(1))
+    bool isValid() const;
+
+    // Copies of a digit beyond the first in a row, column or box, summed over every unit
+    // (O(1)); 0 exactly when isValid(). Only conflicting clues from loadBoard() or
+    // loadPacked() add to it, since insert() refuses a digit its units already hold.
+    int conflictingCells() const;
+
     // Clear the entire board
     void clear();
 };
 
+// Classic 9x9 board
+typedef BasicSudokuBoard<3> SudokuBoard;
+
+// Larger grids
+typedef BasicSudokuBoard<4> SudokuBoard16;
+typedef BasicSudokuBoard<5> SudokuBoard25;
+
 #endif // SUDOKUBOARD_H
@@ -2,27 +2,26 @@ QT       += core gui
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
+# Puzzles are generated off the GUI thread
+QT += concurrent
+
 CONFIG += c++17
 
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+include(core.pri)
+
 SOURCES += \
     main.cpp \
     mainwindow.cpp \
     player.cpp \
-    SudokuBoard.cpp \
-    SudokuSolver.cpp \
-    $$files(data-structures/*.cpp) \
     viewer.cpp
 
 HEADERS += \
     mainwindow.h \
     player.h \
-    sudokuboard.h \
-    SudokuSolver.h \
-    $$files(data-structures/*.h) \
     viewer.h
 
 FORMS += \
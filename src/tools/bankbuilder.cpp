@@ -0,0 +1,139 @@
+// Puzzle bank builder.
+//
+// Generates puzzles for every difficulty with SudokuSolver::generatePuzzle and writes
+// them to a bank file that the game memory-maps (see PuzzleBank.h). Puzzle i of a run
+// is generated from seed (base + i), so a bank can be rebuilt exactly from its seeds.
+//
+// usage: puzzle-bank [-o output] [-n puzzles-per-difficulty] [-t threads] [-s base-seed]
+
+#include "PuzzleBank.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Generate one record from its seed with a worker's own board and solver
+static bool buildRecord(uint32_t seed, SudokuSolver::Difficulty difficulty,
+                        SudokuBoard& board, SudokuSolver& solver, PuzzleRecord& record) {
+    solver.setSeed(seed);
+    if (!solver.generatePuzzle(difficulty)) {
+        return false;
+    }
+
+    int clues[9][9];
+    board.getBoardState(clues);
+    record.rating = static_cast<uint8_t>(solver.getPuzzleRating());
+    record.reserved[0] = record.reserved[1] = 0;
+    record.seed = seed;
+
+    if (!solver.solve()) {
+        return false;
+    }
+    int solution[9][9];
+    board.getBoardState(solution);
+    return packBoard(clues, solution, record.packed) == PACKED_SOLVED_SIZE;
+}
+
+static void printUsage() {
+    cerr << "usage: puzzle-bank [-o output] [-n puzzles-per-difficulty] [-t threads] [-s base-seed]" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    string outputPath = "puzzles.bank";
+    int perLevel = 1000;
+    int threads = static_cast<int>(thread::hardware_concurrency());
+    uint32_t baseSeed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 2;
+        }
+        string value = argv[++i];
+        if (arg == "-o") {
+            outputPath = value;
+        } else if (arg == "-n") {
+            perLevel = atoi(value.c_str());
+        } else if (arg == "-t") {
+            threads = atoi(value.c_str());
+        } else if (arg == "-s") {
+            baseSeed = static_cast<uint32_t>(strtoul(value.c_str(), nullptr, 10));
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (perLevel < 0) {
+        perLevel = 0;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    // Puzzles are numbered level by level; workers take the next number
+    const int levelsCount = SudokuSolver::NUM_DIFFICULTIES;
+    int total = perLevel * levelsCount;
+    vector<PuzzleRecord> levels[SudokuSolver::NUM_DIFFICULTIES];
+    for (int level = 0; level < levelsCount; level++) {
+        levels[level].resize(perLevel);
+    }
+    vector<char> built(total, 0);
+    atomic<int> next(0);
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int w = 0; w < threads; w++) {
+        workers.emplace_back([&]() {
+            SudokuBoard board;
+            SudokuSolver solver(board);
+            int index;
+            while ((index = next.fetch_add(1)) < total) {
+                int level = index / perLevel;
+                built[index] = buildRecord(baseSeed + static_cast<uint32_t>(index),
+                                           SudokuSolver::difficultyAt(level), board, solver,
+                                           levels[level][index % perLevel]) ? 1 : 0;
+            }
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Drop puzzles whose generation failed
+    int failed = 0;
+    for (int level = levelsCount - 1; level >= 0; level--) {
+        for (int i = perLevel - 1; i >= 0; i--) {
+            if (!built[level * perLevel + i]) {
+                levels[level].erase(levels[level].begin() + i);
+                failed++;
+            }
+        }
+    }
+
+    if (!PuzzleBank::write(outputPath, levels)) {
+        cerr << "puzzle-bank: cannot write " << outputPath << endl;
+        return 1;
+    }
+
+    cerr << "puzzles: " << total - failed << " (failed " << failed << ")" << endl;
+    for (int level = 0; level < levelsCount; level++) {
+        int rated[LogicSolver::RATING_EXPERT + 1] = { 0 };
+        for (const PuzzleRecord& record : levels[level]) {
+            rated[record.rating]++;
+        }
+        cerr << "level " << level << ": " << levels[level].size() << " puzzles, rated easy "
+             << rated[LogicSolver::RATING_EASY] << " / medium " << rated[LogicSolver::RATING_MEDIUM]
+             << " / hard " << rated[LogicSolver::RATING_HARD] << " / expert "
+             << rated[LogicSolver::RATING_EXPERT] << endl;
+    }
+    cerr << "time: " << seconds << " s" << endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,282 @@
+// Headless batch solver.
+//
+// Reads puzzles in the common one-line format (81 characters, digits 1-9 for givens and
+// '0' or '.' for empty cells) from a file or stdin, solves them on every core, and writes
+// one line per input line in input order: the solution, or the puzzle unchanged if it is
+// invalid or unsolvable. Blank lines, '#' comments and lines that are not a puzzle are
+// copied through as they are (the last with a warning on stderr), so output line N always
+// belongs to input line N. Throughput and latency percentiles are reported on stderr.
+//
+// usage: sudoku-batch [-i input] [-o output] [-t threads] [-s mrv|dlx|rowmajor]
+
+#include "SudokuSolver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct PuzzleJob {
+    string puzzle;     // Normalized input ('.' for empty cells)
+    string output;     // Line written for this input line
+    bool parsed = false;
+    bool solved = false;
+    long long latencyNs = 0;
+};
+
+// Task queue per worker: the owner pops from the back, idle workers steal from the front
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int workers) : queues(workers), locks(workers) {}
+
+    void push(int worker, int task) {
+        lock_guard<mutex> guard(locks[worker]);
+        queues[worker].push_back(task);
+    }
+
+    // Next task for a worker, stealing if its own queue is empty; false when all are drained
+    bool next(int worker, int& task) {
+        if (popOwn(worker, task)) {
+            return true;
+        }
+        int count = static_cast<int>(queues.size());
+        for (int offset = 1; offset < count; offset++) {
+            if (steal((worker + offset) % count, task)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    vector<deque<int>> queues;
+    vector<mutex> locks;
+
+    bool popOwn(int worker, int& task) {
+        lock_guard<mutex> guard(locks[worker]);
+        if (queues[worker].empty()) {
+            return false;
+        }
+        task = queues[worker].back();
+        queues[worker].pop_back();
+        return true;
+    }
+
+    bool steal(int victim, int& task) {
+        lock_guard<mutex> guard(locks[victim]);
+        if (queues[victim].empty()) {
+            return false;
+        }
+        task = queues[victim].front();
+        queues[victim].pop_front();
+        return true;
+    }
+};
+
+// Parse one input line; returns false if it is not an 81-cell puzzle
+static bool parsePuzzle(const string& line, string& puzzle, int grid[9][9]) {
+    puzzle.clear();
+    for (char ch : line) {
+        if (ch == '\r' || ch == ' ' || ch == '\t') {
+            continue;
+        }
+        if (puzzle.size() == 81) {
+            return false;
+        }
+        if (ch >= '1' && ch <= '9') {
+            puzzle.push_back(ch);
+        } else if (ch == '0' || ch == '.') {
+            puzzle.push_back('.');
+        } else {
+            return false;
+        }
+    }
+    if (puzzle.size() != 81) {
+        return false;
+    }
+
+    for (int i = 0; i < 81; i++) {
+        grid[i / 9][i % 9] = (puzzle[i] == '.') ? 0 : puzzle[i] - '0';
+    }
+    return true;
+}
+
+// Solve one puzzle with a worker's own board and solver
+static void solveJob(PuzzleJob& job, SudokuBoard& board, SudokuSolver& solver) {
+    auto start = chrono::steady_clock::now();
+
+    int grid[9][9];
+    string normalized;
+    parsePuzzle(job.puzzle, normalized, grid);
+
+    board.clear();
+    board.loadBoard(grid);
+
+    job.output = job.puzzle;
+    if (board.isValid() && solver.solve()) {
+        job.solved = true;
+        for (int i = 0; i < 81; i++) {
+            job.output[i] = static_cast<char>('0' + board.getValue(i / 9, i % 9));
+        }
+    }
+
+    job.latencyNs = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+}
+
+static void printUsage() {
+    cerr << "usage: sudoku-batch [-i input] [-o output] [-t threads] [-s mrv|dlx|rowmajor]" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    string inputPath;
+    string outputPath;
+    int threads = static_cast<int>(thread::hardware_concurrency());
+    SudokuSolver::Strategy strategy = SudokuSolver::MRV_LCV;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 2;
+        }
+        string value = argv[++i];
+        if (arg == "-i") {
+            inputPath = value;
+        } else if (arg == "-o") {
+            outputPath = value;
+        } else if (arg == "-t") {
+            threads = atoi(value.c_str());
+        } else if (arg == "-s") {
+            if (value == "mrv") {
+                strategy = SudokuSolver::MRV_LCV;
+            } else if (value == "dlx") {
+                strategy = SudokuSolver::DANCING_LINKS;
+            } else if (value == "rowmajor") {
+                strategy = SudokuSolver::ROW_MAJOR;
+            } else {
+                printUsage();
+                return 2;
+            }
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    // Read every puzzle up front so results can be written in input order
+    ifstream inputFile;
+    if (!inputPath.empty()) {
+        inputFile.open(inputPath);
+        if (!inputFile) {
+            cerr << "sudoku-batch: cannot open " << inputPath << endl;
+            return 1;
+        }
+    }
+    istream& input = inputPath.empty() ? cin : inputFile;
+
+    vector<PuzzleJob> jobs;
+    vector<int> puzzles;  // Indices of the jobs that hold a puzzle
+    string line;
+    int lineNumber = 0;
+    int skipped = 0;
+    while (getline(input, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        PuzzleJob job;
+        job.output = line;
+        int grid[9][9];
+        if (!line.empty() && line[0] != '#') {
+            if (parsePuzzle(line, job.puzzle, grid)) {
+                job.parsed = true;
+                puzzles.push_back(static_cast<int>(jobs.size()));
+            } else {
+                cerr << "sudoku-batch: line " << lineNumber << ": not an 81-cell puzzle, copied unchanged" << endl;
+                skipped++;
+            }
+        }
+        jobs.push_back(job);
+    }
+
+    int count = static_cast<int>(puzzles.size());
+    threads = min(threads, max(count, 1));
+
+    // Deal contiguous blocks to the workers; stealing evens out slow puzzles
+    WorkStealingPool pool(threads);
+    for (int i = 0; i < count; i++) {
+        pool.push(static_cast<int>(static_cast<long long>(i) * threads / max(count, 1)), puzzles[i]);
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int w = 0; w < threads; w++) {
+        workers.emplace_back([w, strategy, &pool, &jobs]() {
+            SudokuBoard board;
+            SudokuSolver solver(board, strategy);
+            int task;
+            while (pool.next(w, task)) {
+                solveJob(jobs[task], board, solver);
+            }
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Results in input order
+    ofstream outputFile;
+    if (!outputPath.empty()) {
+        outputFile.open(outputPath);
+        if (!outputFile) {
+            cerr << "sudoku-batch: cannot write " << outputPath << endl;
+            return 1;
+        }
+    }
+    ostream& output = outputPath.empty() ? cout : outputFile;
+
+    int solved = 0;
+    vector<long long> latencies;
+    latencies.reserve(count);
+    for (const PuzzleJob& job : jobs) {
+        output << job.output << '\n';
+        if (job.parsed) {
+            solved += job.solved ? 1 : 0;
+            latencies.push_back(job.latencyNs);
+        }
+    }
+    output.flush();
+
+    // Report
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) -> double {
+        if (latencies.empty()) {
+            return 0.0;
+        }
+        size_t index = static_cast<size_t>(p * (latencies.size() - 1) + 0.5);
+        return latencies[index] / 1000.0;
+    };
+
+    cerr << "puzzles: " << count << " (solved " << solved << ", unsolved " << count - solved
+         << ", skipped lines " << skipped << ")" << endl;
+    cerr << "threads: " << threads << endl;
+    cerr << "time: " << seconds << " s, " << (seconds > 0 ? count / seconds : 0.0) << " puzzles/s" << endl;
+    cerr << "latency: p50 " << percentile(0.50) << " us, p99 " << percentile(0.99) << " us" << endl;
+
+    return solved == count ? 0 : 1;
+}
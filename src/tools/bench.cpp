@@ -0,0 +1,444 @@
+// Micro-benchmark suite for the board, the solvers and the data structures.
+//
+// Runs every benchmark on a fixed corpus (and fixed generator seeds) so numbers are
+// comparable between builds, and prints one JSON document on stdout with, per
+// benchmark, the mean ns/op, heap allocations/op and p50/p90/p99 of the per-sample
+// ns/op. Allocations are counted by replacing the global operator new.
+//
+// usage: sudoku-bench [-f name-filter] [-n samples]
+
+#include "SudokuSolver.h"
+#include "CandidateKernel.h"
+#include "BoardCodec.h"
+#include "data-structures/hashtable.h"
+#include "data-structures/customVector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Allocation counting
+
+static atomic<long long> allocationCount(0);
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+    free(memory);
+}
+
+// Corpus
+
+struct CorpusPuzzle {
+    const char* name;
+    const char* text;
+    bool backtrackingFriendly;  // Finishes quickly with the MRV backtracker
+    bool rowMajorFriendly;      // Finishes quickly with the row-major backtracker too
+};
+
+static const CorpusPuzzle CORPUS[] = {
+    // Easy: solved by singles alone
+    { "easy", "..3.2.6..9..3.5..1..18.64....81.29..7.......8..67.82....26.95..8..2.3..9..5.1.3..", true, true },
+    // Hard: need guessing
+    { "hard", "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......", true, false },
+    { "escargot", "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..", true, true },
+    { "golden-nugget", ".......39.....1..5..3.5.8....8.9...6.7...2..1..4.......9.8..5..2....6..4..7......", true, true },
+    // Pathological: first row's solution is 987654321, the worst case for row-major search
+    { "anti-backtracking", "..............3.85..1.2.......5.7.....4...1...9.......5......73..2.1........4...9", true, false },
+    // Pathological: no solution, but no conflict until deep in the search
+    { "unsolvable", ".....5.8....6.1.43..........1.5........1.6...3.......553.....61........4.........", false, false }
+};
+static const int CORPUS_SIZE = sizeof(CORPUS) / sizeof(CORPUS[0]);
+
+// Solution of the easy puzzle, used to fill boards cell by cell
+static const char* EASY_SOLUTION =
+    "483921657967345821251876493548132976729564138136798245372689514814253769695417382";
+
+static const unsigned int GENERATOR_SEED = 12345;
+
+// Measurement
+
+struct BenchResult {
+    string name;
+    long long ops;
+    double nsPerOp;
+    double allocsPerOp;
+    double p50;
+    double p90;
+    double p99;
+};
+
+static vector<BenchResult> results;
+static string nameFilter;
+static int sampleCount = 200;
+
+// Run `batch` timed calls of body(i) per sample, after an untimed prepare()
+template <typename Prepare, typename Body>
+static void bench(const string& name, int samples, int batch, Prepare prepare, Body body) {
+    if (!nameFilter.empty() && name.find(nameFilter) == string::npos) {
+        return;
+    }
+
+    // Warm up caches and lazily built tables
+    prepare();
+    for (int i = 0; i < batch; i++) {
+        body(i);
+    }
+
+    vector<double> perOp;
+    perOp.reserve(samples);
+    double totalNs = 0;
+    long long allocations = 0;
+    for (int s = 0; s < samples; s++) {
+        prepare();
+        long long allocsBefore = allocationCount.load(memory_order_relaxed);
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < batch; i++) {
+            body(i);
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        allocations += allocationCount.load(memory_order_relaxed) - allocsBefore;
+        totalNs += ns;
+        perOp.push_back(ns / batch);
+    }
+
+    sort(perOp.begin(), perOp.end());
+    auto percentile = [&perOp](double p) {
+        return perOp[static_cast<size_t>(p * (perOp.size() - 1) + 0.5)];
+    };
+
+    long long ops = static_cast<long long>(samples) * batch;
+    results.push_back({ name, ops, totalNs / ops, static_cast<double>(allocations) / ops,
+                        percentile(0.50), percentile(0.90), percentile(0.99) });
+    fprintf(stderr, "%-40s %12.1f ns/op %8.2f allocs/op\n", name.c_str(), totalNs / ops,
+            static_cast<double>(allocations) / ops);
+}
+
+// Keep results alive so the optimizer cannot drop the work
+static volatile long long sink;
+
+// Benchmarks
+
+static void benchBoard() {
+    int solution[9][9];
+    decodeText(EASY_SOLUTION, solution);
+    int easy[9][9];
+    decodeText(CORPUS[0].text, easy);
+
+    SudokuBoard board;
+
+    bench("board.insert", sampleCount, 81,
+          [&]() { board.clear(); },
+          [&](int i) { sink += board.insert(i / 9, i % 9, solution[i / 9][i % 9]); });
+
+    bench("board.remove", sampleCount, 81,
+          [&]() { board.clear(); board.loadBoard(solution); },
+          [&](int i) { sink += board.remove(i / 9, i % 9); });
+
+    // Inserts logged on the trail, taken back one at a time newest first
+    bench("board.undoTo", sampleCount, 81,
+          [&]() {
+              board.clear();
+              for (int cell = 0; cell < 81; cell++) {
+                  board.insert(cell / 9, cell % 9, solution[cell / 9][cell % 9]);
+              }
+          },
+          [&](int i) { sink += board.undoTo(80 - i); });
+
+    board.clear();
+    board.loadBoard(easy);
+    bench("board.calculateDomain", sampleCount, 81,
+          []() {},
+          [&](int i) { sink += board.calculateDomain(i / 9, i % 9).size(); });
+
+    bench("board.calculateDomainMask", sampleCount, 81,
+          []() {},
+          [&](int i) { sink += board.calculateDomainMask(i / 9, i % 9); });
+
+    unsigned short masks[81];
+    bench("board.calculateAllDomainMasks", sampleCount, 100,
+          []() {},
+          [&](int) { board.calculateAllDomainMasks(masks); sink += masks[0]; });
+
+    bench("board.loadBoard", sampleCount, 10,
+          []() {},
+          [&](int) { board.clear(); board.loadBoard(easy); });
+
+    SudokuBoard::Snapshot saved = board.snapshot();
+    bench("board.snapshot", sampleCount, 100,
+          []() {},
+          [&](int) { saved = board.snapshot(); sink += saved.cells[0][2]; });
+
+    bench("board.restore", sampleCount, 100,
+          []() {},
+          [&](int) { board.restore(saved); sink += board.getValue(0, 2); });
+
+    bench("board.isComplete+isValid", sampleCount, 100,
+          []() {},
+          [&](int) { sink += board.isComplete() + board.isValid(); });
+
+    SudokuBoard copy;
+    bench("board.copy", sampleCount, 100,
+          []() {},
+          [&](int) { copy = board; sink += copy.getValue(0, 2); });
+
+    uint8_t packed[PACKED_MAX_SIZE];
+    size_t packedSize = packBoard(easy, packed);
+    bench("board.loadPacked", sampleCount, 10,
+          []() {},
+          [&](int) { sink += board.loadPacked(PackedBoardView(packed, packedSize)); });
+}
+
+static void benchSolver() {
+    struct StrategyName {
+        SudokuSolver::Strategy strategy;
+        const char* name;
+    };
+    static const StrategyName strategies[] = {
+        { SudokuSolver::ROW_MAJOR, "rowmajor" },
+        { SudokuSolver::MRV_LCV, "mrv" },
+        { SudokuSolver::DANCING_LINKS, "dlx" }
+    };
+
+    SudokuBoard board;
+    SudokuSolver solver(board);
+
+    for (int p = 0; p < CORPUS_SIZE; p++) {
+        int grid[9][9];
+        decodeText(CORPUS[p].text, grid);
+        auto reload = [&]() { board.clear(); board.loadBoard(grid); };
+
+        for (const StrategyName& entry : strategies) {
+            // Backtracking takes seconds or more on the pathological puzzles
+            if (entry.strategy == SudokuSolver::MRV_LCV && !CORPUS[p].backtrackingFriendly) {
+                continue;
+            }
+            if (entry.strategy == SudokuSolver::ROW_MAJOR && !CORPUS[p].rowMajorFriendly) {
+                continue;
+            }
+            solver.setStrategy(entry.strategy);
+            int samples = CORPUS[p].backtrackingFriendly ? sampleCount / 4 : 5;
+            bench(string("solver.solve/") + entry.name + "/" + CORPUS[p].name, samples, 1,
+                  reload, [&](int) { sink += solver.solve(); });
+        }
+
+        solver.setStrategy(SudokuSolver::MRV_LCV);
+        if (CORPUS[p].backtrackingFriendly) {
+            bench(string("solver.isSolvable/") + CORPUS[p].name, sampleCount / 4, 1,
+                  reload, [&](int) { sink += solver.isSolvable(); });
+            bench(string("solver.hasUniqueSolution/") + CORPUS[p].name, sampleCount / 4, 1,
+                  reload, [&](int) { sink += solver.hasUniqueSolution(); });
+        }
+    }
+
+    int easy[9][9];
+    decodeText(CORPUS[0].text, easy);
+    bench("solver.getHint", sampleCount, 100,
+          [&]() { board.clear(); board.loadBoard(easy); },
+          [&](int) { sink += solver.getHint().first; });
+
+    // Generation cost varies a lot from puzzle to puzzle; the seed fixes the sequence
+    for (int level = 0; level < SudokuSolver::NUM_DIFFICULTIES; level++) {
+        static const char* levelNames[] = { "easy", "medium", "hard", "expert" };
+        solver.setSeed(GENERATOR_SEED);
+        bench(string("solver.generatePuzzle/") + levelNames[level], 20, 1,
+              []() {},
+              [&](int) { sink += solver.generatePuzzle(SudokuSolver::difficultyAt(level)); });
+    }
+
+    // Larger grids: the same solver API over 16x16 and 25x25 boards
+    static SudokuBoard16 board16;
+    SudokuSolver16 solver16(board16);
+    solver16.setSeed(GENERATOR_SEED);
+    bench("solver16.generateSolvedBoard", 20, 1,
+          []() {},
+          [&](int) { sink += solver16.generateSolvedBoard(); });
+    bench("solver16.generatePuzzle/easy", 5, 1,
+          []() {},
+          [&](int) { sink += solver16.generatePuzzle(SudokuSolver16::EASY); });
+
+    // Solve the last generated puzzle back (sudoku-tests checks the solutions)
+    SudokuBoard16::Snapshot puzzle16 = board16.snapshot();
+    for (const StrategyName& entry : strategies) {
+        if (entry.strategy == SudokuSolver::ROW_MAJOR) {
+            continue;
+        }
+        solver16.setStrategy(entry.strategy);
+        bench(string("solver16.solve/") + entry.name, 20, 1,
+              [&]() { board16.restore(puzzle16); },
+              [&](int) { sink += solver16.solve(); });
+    }
+
+    static SudokuBoard25 board25;
+    SudokuSolver25 solver25(board25);
+    solver25.setSeed(GENERATOR_SEED);
+    bench("solver25.generateSolvedBoard", 5, 1,
+          []() {},
+          [&](int) { sink += solver25.generateSolvedBoard(); });
+    bench("solver25.generatePuzzle/easy", 5, 1,
+          []() {},
+          [&](int) { sink += solver25.generatePuzzle(SudokuSolver25::EASY); });
+
+    SudokuBoard25::Snapshot puzzle25 = board25.snapshot();
+    for (const StrategyName& entry : strategies) {
+        if (entry.strategy == SudokuSolver::ROW_MAJOR) {
+            continue;
+        }
+        solver25.setStrategy(entry.strategy);
+        bench(string("solver25.solve/") + entry.name, 5, 1,
+              [&]() { board25.restore(puzzle25); },
+              [&](int) { sink += solver25.solve(); });
+    }
+}
+
+static void benchContainers() {
+    unorderedSet set;
+    bench("unorderedSet.insert", sampleCount, 9,
+          [&]() { set.clear(); },
+          [&](int i) { set.insert(i + 1); });
+
+    bench("unorderedSet.contains", sampleCount, 100,
+          []() {},
+          [&](int i) { sink += set.contains(i % 12); });
+
+    bench("unorderedSet.iterate", sampleCount, 10,
+          []() {},
+          [&](int) {
+              for (int value : set) {
+                  sink += value;
+              }
+          });
+
+    bench("unorderedSet.copy", sampleCount, 10,
+          []() {},
+          [&](int) { unorderedSet copy(set); sink += copy.size(); });
+
+    // Keys past the inline bitset go to overflow nodes
+    unorderedSet heapSet;
+    bench("unorderedSet.insert-large/heap", sampleCount, 100,
+          [&]() { heapSet.clear(); },
+          [&](int i) { heapSet.insert(1000 + i); });
+
+    unorderedSet::NodePool nodePool;
+    unorderedSet pooledSet(&nodePool);
+    bench("unorderedSet.insert-large/pool", sampleCount, 100,
+          [&]() { pooledSet.clear(); },
+          [&](int i) { pooledSet.insert(1000 + i); });
+
+    CustomVector<int> vector;
+    bench("CustomVector.push_back", sampleCount, 100,
+          [&]() { vector.clear(); },
+          [&](int i) { vector.push_back(i); });
+
+    bench("CustomVector.index", sampleCount, 100,
+          []() {},
+          [&](int i) { sink += vector[i]; });
+
+    hashtable table;
+    bench("hashtable.insert", sampleCount, 100,
+          [&]() { table.clear(); },
+          [&](int i) { table.insert(i * 7, i); });
+
+    bench("hashtable.get", sampleCount, 100,
+          []() {},
+          [&](int i) { sink += table.get(i * 7); });
+
+    // Large enough that the table resizes several times and leaves the cache
+    const int mapKeys = 1 << 20;
+    HashMap<unsigned long long, int> map;
+    bench("HashMap.insert/1M", 5, mapKeys,
+          [&]() { map = HashMap<unsigned long long, int>(); },
+          [&](int i) { map.insert(i * 0x9E3779B97F4A7C15ULL, i); });
+
+    bench("HashMap.find/1M", 5, mapKeys,
+          []() {},
+          [&](int i) { sink += *map.find(i * 0x9E3779B97F4A7C15ULL); });
+
+    bench("HashMap.find-miss/1M", 5, mapKeys,
+          []() {},
+          [&](int i) { sink += map.contains(i * 0x9E3779B97F4A7C15ULL + 1); });
+
+    // Scratch map thrown away with one arena reset per sample
+    Arena arena;
+    HashMap<int, int> scratch(&arena);
+    bench("HashMap.insert/arena", sampleCount, 1000,
+          [&]() { arena.reset(); scratch.clear(); },
+          [&](int i) { scratch.insert(i * 7, i); });
+
+    SudokuBoard board;
+    const Graph& graph = board.getGraph();
+    bench("Graph.getNeighbors", sampleCount, 81,
+          []() {},
+          [&](int i) { sink += graph.getNeighbors(i / 9, i % 9).size(); });
+}
+
+static void printJson() {
+    printf("{\n  \"candidateKernel\": \"%s\",\n  \"benchmarks\": [\n", candidateKernelName());
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        printf("    {\"name\": \"%s\", \"ops\": %lld, \"ns_per_op\": %.2f, \"allocs_per_op\": %.3f, "
+               "\"p50_ns\": %.2f, \"p90_ns\": %.2f, \"p99_ns\": %.2f}%s\n",
+               r.name.c_str(), r.ops, r.nsPerOp, r.allocsPerOp, r.p50, r.p90, r.p99,
+               i + 1 < results.size() ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
+
+static void printUsage() {
+    fprintf(stderr, "usage: sudoku-bench [-f name-filter] [-n samples]\n");
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 2;
+        }
+        string value = argv[++i];
+        if (arg == "-f") {
+            nameFilter = value;
+        } else if (arg == "-n") {
+            sampleCount = max(atoi(value.c_str()), 4);
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    benchBoard();
+    benchSolver();
+    benchContainers();
+    printJson();
+    return 0;
+}
@@ -0,0 +1,11 @@
+# Puzzle bank builder: no Qt modules, engine sources only.
+TEMPLATE = app
+TARGET = puzzle-bank
+
+CONFIG += console c++17 thread
+CONFIG -= qt app_bundle
+
+include(../core.pri)
+
+SOURCES += \
+    bankbuilder.cpp
@@ -0,0 +1,11 @@
+# Headless batch solver: no Qt modules, engine sources only.
+TEMPLATE = app
+TARGET = sudoku-batch
+
+CONFIG += console c++17 thread
+CONFIG -= qt app_bundle
+
+include(../core.pri)
+
+SOURCES += \
+    batch.cpp
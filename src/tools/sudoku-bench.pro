@@ -0,0 +1,11 @@
+# Micro-benchmark suite: no Qt modules, engine sources only.
+TEMPLATE = app
+TARGET = sudoku-bench
+
+CONFIG += console c++17 thread
+CONFIG -= qt app_bundle
+
+include(../core.pri)
+
+SOURCES += \
+    bench.cpp
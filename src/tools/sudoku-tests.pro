@@ -0,0 +1,11 @@
+# Trail and large-grid checks: no Qt modules, engine sources only.
+TEMPLATE = app
+TARGET = sudoku-tests
+
+CONFIG += console c++17 thread
+CONFIG -= qt app_bundle
+
+include(../core.pri)
+
+SOURCES += \
+    tests.cpp
@@ -0,0 +1,405 @@
+// Consistency checks for the board's backtracking trail and the larger grids.
+//
+// Every solver path relies on mark()/undoTo() giving back exactly the state taken at a
+// mark, so these drive a board through long random sequences of inserts, overwrites,
+// removes, undos and snapshot restores, and compare the full state (values, fixed
+// cells, used-digit masks, digit counts, domains, fill and conflict counts) with what
+// it must be after each step, including on boards loaded with conflicting clues. Then puzzles are generated on 16x16 and 25x25 boards and solved back with
+// every strategy, which must all find the same unique solution. Prints the first
+// failing check on stderr and exits with status 1.
+//
+// usage: sudoku-tests
+
+#include "SudokuSolver.h"
+#include "BoardCodec.h"
+#include "data-structures/bitmask.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+static const char* PUZZLES[] = {
+    "..3.2.6..9..3.5..1..18.64....81.29..7.......8..67.82....26.95..8..2.3..9..5.1.3..",
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......",
+    ".......39.....1..5..3.5.8....8.9...6.7...2..1..4.......9.8..5..2....6..4..7......",
+    "................................................................................."
+};
+static const int PUZZLE_COUNT = sizeof(PUZZLES) / sizeof(PUZZLES[0]);
+
+static const unsigned int SEED = 12345;
+static const int ROUNDS = 200;
+static const int STEPS = 120;
+
+static int failures = 0;
+
+static void fail(const char* check, int round, int step) {
+    fprintf(stderr, "%s failed: round %d step %d\n", check, round, step);
+    failures++;
+}
+
+// Whether two snapshots hold the same state (field by field, so padding is ignored)
+static bool sameState(const SudokuBoard::Snapshot& a, const SudokuBoard::Snapshot& b) {
+    return memcmp(a.cells, b.cells, sizeof(a.cells)) == 0
+        && memcmp(a.fixedCells, b.fixedCells, sizeof(a.fixedCells)) == 0
+        && memcmp(a.rowUsed, b.rowUsed, sizeof(a.rowUsed)) == 0
+        && memcmp(a.colUsed, b.colUsed, sizeof(a.colUsed)) == 0
+        && memcmp(a.boxUsed, b.boxUsed, sizeof(a.boxUsed)) == 0
+        && memcmp(a.domains, b.domains, sizeof(a.domains)) == 0
+        && memcmp(a.rowCount, b.rowCount, sizeof(a.rowCount)) == 0
+        && memcmp(a.colCount, b.colCount, sizeof(a.colCount)) == 0
+        && memcmp(a.boxCount, b.boxCount, sizeof(a.boxCount)) == 0
+        && a.filledCount == b.filledCount
+        && a.conflictCount == b.conflictCount;
+}
+
+// Whether the domains are the ones a full recalculation gives for the current values
+static bool domainsConsistent(const SudokuBoard& board) {
+    SudokuBoard fresh = board;
+    fresh.recalculateDomains();
+    return sameState(board.snapshot(), fresh.snapshot());
+}
+
+static void loadPuzzle(SudokuBoard& board, int round) {
+    int grid[9][9];
+    decodeText(PUZZLES[round % PUZZLE_COUNT], grid);
+    board.loadBoard(grid);
+}
+
+// A random digit the cell's row, column and box allow, or 0 if there is none
+static int randomCandidate(const SudokuBoard& board, int cell, mt19937& rng) {
+    unsigned int domain = board.calculateDomainMask(cell / 9, cell % 9);
+    if (domain == 0) {
+        return 0;
+    }
+    for (int skip = rng() % countBits(domain); skip > 0; skip--) {
+        domain &= domain - 1;
+    }
+    return lowestValue(domain);
+}
+
+// Random inserts into empty cells with nested marks; every undoTo must give back
+// exactly the snapshot taken at its mark
+static void checkNestedMarks() {
+    mt19937 rng(SEED);
+    SudokuBoard board;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        loadPuzzle(board, round);
+
+        vector<pair<int, SudokuBoard::Snapshot>> marks;
+        marks.push_back(make_pair(board.mark(), board.snapshot()));
+        for (int step = 0; step < STEPS; step++) {
+            if (rng() % 3 != 0) {
+                int cell = rng() % 81;
+                int value = randomCandidate(board, cell, rng);
+                if (!board.isEmpty(cell / 9, cell % 9) || value == 0) {
+                    continue;
+                }
+                if (rng() % 2 == 0) {
+                    marks.push_back(make_pair(board.mark(), board.snapshot()));
+                }
+                board.insert(cell / 9, cell % 9, value);
+            } else {
+                size_t level = rng() % marks.size();
+                if (!board.undoTo(marks[level].first) || !sameState(board.snapshot(), marks[level].second)) {
+                    fail("nested marks", round, step);
+                    return;
+                }
+                marks.resize(level + 1);
+            }
+        }
+        if (!board.undoTo(marks[0].first) || !sameState(board.snapshot(), marks[0].second)) {
+            fail("nested marks", round, STEPS);
+            return;
+        }
+    }
+}
+
+// Inserts, overwrites and removes interleaved with marks and undos. remove() and an
+// overwriting insert reset the trail, so marks taken before one are dropped; marks taken
+// since must still undo exactly, and the domains must match a full recalculation after
+// every step.
+static void checkRemoveInterleaving() {
+    mt19937 rng(SEED + 1);
+    SudokuBoard board;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        loadPuzzle(board, round);
+
+        vector<pair<int, SudokuBoard::Snapshot>> marks;
+        marks.push_back(make_pair(board.mark(), board.snapshot()));
+        for (int step = 0; step < STEPS; step++) {
+            int cell = rng() % 81;
+            int row = cell / 9;
+            int col = cell % 9;
+            int action = rng() % 6;
+
+            if (action <= 2) {
+                // Insert, overwriting whatever a non-fixed cell holds
+                int value = randomCandidate(board, cell, rng);
+                if (board.isFixedCell(row, col) || value == 0) {
+                    continue;
+                }
+                bool overwrite = !board.isEmpty(row, col) && board.getValue(row, col) != value;
+                if (rng() % 2 == 0) {
+                    marks.push_back(make_pair(board.mark(), board.snapshot()));
+                }
+                if (!board.insert(row, col, value) || board.getValue(row, col) != value) {
+                    fail("insert", round, step);
+                    return;
+                }
+                if (overwrite) {
+                    // The old value's removal resets the trail; only the new value is on it
+                    if (board.mark() != 1) {
+                        fail("overwrite resets the trail", round, step);
+                        return;
+                    }
+                    marks.assign(1, make_pair(board.mark(), board.snapshot()));
+                }
+            } else if (action <= 4) {
+                if (board.isFixedCell(row, col)) {
+                    continue;
+                }
+                int markBefore = board.mark();
+                if (!board.remove(row, col) || !board.isEmpty(row, col) || board.mark() != 0) {
+                    fail("remove", round, step);
+                    return;
+                }
+                if (markBefore > 0 && board.undoTo(markBefore)) {
+                    fail("undoTo rejects a mark from before remove", round, step);
+                    return;
+                }
+                marks.assign(1, make_pair(board.mark(), board.snapshot()));
+            } else {
+                size_t level = rng() % marks.size();
+                if (!board.undoTo(marks[level].first) || !sameState(board.snapshot(), marks[level].second)) {
+                    fail("undoTo after remove", round, step);
+                    return;
+                }
+                marks.resize(level + 1);
+            }
+
+            if (!domainsConsistent(board)) {
+                fail("domains after insert/remove", round, step);
+                return;
+            }
+        }
+    }
+}
+
+// restore() gives back a snapshot exactly and resets the trail, and inserts made after
+// a restore undo back to the restored state
+static void checkRestore() {
+    mt19937 rng(SEED + 2);
+    SudokuBoard board;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        loadPuzzle(board, round);
+
+        SudokuBoard::Snapshot saved = board.snapshot();
+        for (int step = 0; step < STEPS; step++) {
+            int cell = rng() % 81;
+            int row = cell / 9;
+            int col = cell % 9;
+            int action = rng() % 8;
+
+            if (action <= 4) {
+                int value = randomCandidate(board, cell, rng);
+                if (!board.isFixedCell(row, col) && value != 0) {
+                    board.insert(row, col, value);
+                }
+            } else if (action == 5) {
+                if (!board.isFixedCell(row, col)) {
+                    board.remove(row, col);
+                }
+            } else if (action == 6) {
+                saved = board.snapshot();
+            } else {
+                int markBefore = board.mark();
+                board.restore(saved);
+                if (!sameState(board.snapshot(), saved) || board.mark() != 0) {
+                    fail("restore", round, step);
+                    return;
+                }
+                if (markBefore > 0 && board.undoTo(markBefore)) {
+                    fail("undoTo rejects a mark from before restore", round, step);
+                    return;
+                }
+
+                // Inserts after the restore undo back to it
+                for (int i = 0; i < 10; i++) {
+                    int other = rng() % 81;
+                    int value = randomCandidate(board, other, rng);
+                    if (board.isEmpty(other / 9, other % 9) && value != 0) {
+                        board.insert(other / 9, other % 9, value);
+                    }
+                }
+                if (!board.undoTo(0) || !sameState(board.snapshot(), saved)) {
+                    fail("undoTo after restore", round, step);
+                    return;
+                }
+            }
+
+            if (!domainsConsistent(board)) {
+                fail("domains around restore", round, step);
+                return;
+            }
+        }
+    }
+}
+
+// Conflicting clues are loaded and counted, and the count follows removes, undos and
+// restores: a digit repeated k times in a unit adds k - 1
+static void checkConflicts() {
+    int grid[9][9];
+    decodeText(PUZZLES[0], grid);
+    grid[0][0] = 3;  // Row 0 and box 0 already hold a 3 at (0, 2)
+    grid[8][0] = 8;  // Column 0 and box 6 already hold an 8 at (7, 0)
+
+    SudokuBoard board;
+    board.loadBoard(grid);
+    if (board.isValid() || board.conflictingCells() != 4 || board.getValue(0, 0) != 3) {
+        fail("conflicting clues are counted", 0, 0);
+        return;
+    }
+    if (!domainsConsistent(board)) {
+        fail("domains with conflicting clues", 0, 0);
+        return;
+    }
+
+    // Solvers refuse the board rather than fill it around the conflict
+    SudokuSolver solver(board);
+    SudokuBoard::Snapshot loaded = board.snapshot();
+    if (solver.solve() || !sameState(board.snapshot(), loaded)) {
+        fail("solve refuses conflicting clues", 0, 1);
+        return;
+    }
+
+    // Taking one copy out keeps the other's digit in the row, column and box
+    board.remove(0, 2);
+    if (board.conflictingCells() != 2 || (board.calculateDomainMask(0, 2) & maskBit(3))) {
+        fail("remove one conflicting copy", 0, 2);
+        return;
+    }
+    board.remove(8, 0);
+    if (!board.isValid() || board.conflictingCells() != 0 || !domainsConsistent(board)) {
+        fail("remove the last conflict", 0, 3);
+        return;
+    }
+
+    // Inserts on the now valid board undo back to it, and restore brings the conflicts back
+    SudokuBoard::Snapshot valid = board.snapshot();
+    int trailMark = board.mark();
+    mt19937 rng(SEED + 3);
+    for (int i = 0; i < 20; i++) {
+        int cell = rng() % 81;
+        int value = randomCandidate(board, cell, rng);
+        if (board.isEmpty(cell / 9, cell % 9) && value != 0) {
+            board.insert(cell / 9, cell % 9, value);
+        }
+    }
+    if (!board.isValid() || !board.undoTo(trailMark) || !sameState(board.snapshot(), valid)) {
+        fail("undo on a board cleared of conflicts", 0, 4);
+        return;
+    }
+    board.restore(loaded);
+    if (board.conflictingCells() != 4 || !sameState(board.snapshot(), loaded)) {
+        fail("restore brings the conflicts back", 0, 5);
+        return;
+    }
+
+    // The packed loader reports and keeps them the same way
+    uint8_t packed[PACKED_MAX_SIZE];
+    size_t packedSize = packBoard(grid, packed);
+    SudokuBoard unpacked;
+    if (unpacked.loadPacked(PackedBoardView(packed, packedSize)) || unpacked.conflictingCells() != 4
+        || !sameState(unpacked.snapshot(), loaded)) {
+        fail("loadPacked keeps and reports conflicts", 0, 6);
+        return;
+    }
+}
+
+// Whether every row, column and box of a full grid holds each digit once
+template <int BoxSize>
+static bool isSolution(const BasicSudokuBoard<BoxSize>& board) {
+    typedef BasicSudokuBoard<BoxSize> Board;
+    const unsigned long long all = (1ull << Board::SIZE) - 1;
+    for (int unit = 0; unit < Board::SIZE; unit++) {
+        unsigned long long row = 0;
+        unsigned long long col = 0;
+        unsigned long long box = 0;
+        for (int i = 0; i < Board::SIZE; i++) {
+            int boxRow = (unit / BoxSize) * BoxSize + i / BoxSize;
+            int boxCol = (unit % BoxSize) * BoxSize + i % BoxSize;
+            row |= 1ull << (board.getValue(unit, i) - 1);
+            col |= 1ull << (board.getValue(i, unit) - 1);
+            box |= 1ull << (board.getValue(boxRow, boxCol) - 1);
+        }
+        if (row != all || col != all || box != all) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Generate puzzles and solve them back with each strategy: every solve must keep the
+// clues, fill a valid grid and agree with the others, since the solution is unique
+template <int BoxSize>
+static void checkRoundTrip(const char* name, int puzzles) {
+    typedef BasicSudokuBoard<BoxSize> Board;
+    typedef BasicSudokuSolver<BoxSize> Solver;
+    static const typename Solver::Strategy strategies[] = { Solver::MRV_LCV, Solver::DANCING_LINKS };
+
+    static Board board;
+    Solver solver(board);
+    solver.setSeed(SEED);
+
+    for (int round = 0; round < puzzles; round++) {
+        if (!solver.generatePuzzle(Solver::EASY) || !solver.hasUniqueSolution()) {
+            fail(name, round, 0);
+            return;
+        }
+        typename Board::Snapshot puzzle = board.snapshot();
+
+        static int first[Board::SIZE][Board::SIZE];
+        for (int s = 0; s < 2; s++) {
+            board.restore(puzzle);
+            solver.setStrategy(strategies[s]);
+            if (!solver.solve() || !board.isComplete() || !isSolution(board)) {
+                fail(name, round, s + 1);
+                return;
+            }
+            for (int row = 0; row < Board::SIZE; row++) {
+                for (int col = 0; col < Board::SIZE; col++) {
+                    int value = board.getValue(row, col);
+                    int clue = puzzle.cells[row][col];
+                    if ((clue != 0 && value != clue) || (s > 0 && value != first[row][col])) {
+                        fail(name, round, s + 1);
+                        return;
+                    }
+                    first[row][col] = value;
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    checkNestedMarks();
+    checkRemoveInterleaving();
+    checkRestore();
+    checkConflicts();
+    checkRoundTrip<4>("16x16 round trip", 5);
+    checkRoundTrip<5>("25x25 round trip", 2);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <QDialog>
 #include <QVBoxLayout>
 #include <QKeyEvent>
+#include <QtConcurrent>
 
 viewer::viewer(int d, QWidget *parent) :
     QMainWindow(parent)
@@ -11,17 +12,24 @@ viewer::viewer(int d, QWidget *parent) :
     initUI();
     this->setFixedSize(500, 500);
 
-    //game
-    gamePlayer.startgame(diff);
-    loadboard();
-
     timer = new QTimer(this);
     connect(timer, &QTimer::timeout, this, &viewer::update);
+
+    //game: start at once if a puzzle is ready, otherwise generate one in the background
+    PuzzleGrid puzzle;
+    if (player::takeReadyPuzzle(diff, puzzle)) {
+        gamePlayer.startgame(diff, puzzle);
+        loadboard();
+    } else {
+        startGeneration();
+    }
+
     timer->start(500);
 }
 
 viewer::~viewer()
 {
+    cancelGeneration();
     for(int i = 0; i < labellist.size(); i++)
     {
         for(int j = 0; j < labellist[i].size(); j++)
@@ -40,6 +48,13 @@ viewer::~viewer()
 
 void viewer::update()
 {
+    if (loading)
+    {
+        int percent = job ? job->progress.load() : 0;
+        time->setText("Generating " + QString::number(percent) + "%");
+        return;
+    }
+
     static int shown = 0;
     if(gamePlayer.getScore() == 0 && shown == 0)
     {
@@ -49,7 +64,6 @@ void viewer::update()
     }
     else
     {
-        savemove();
         score->setText(QString::fromStdString(to_string(gamePlayer.getScore())));
         int elapsed = gamePlayer.getElapsedTime();
         int mins = elapsed / 60;
@@ -69,19 +83,20 @@ void viewer::gethintpress()
     pair<int, int> hintCell = gamePlayer.getHint();
     if (hintCell.first != -1)
     {
-        unorderedSet domain = gamePlayer.getBoard()->calculateDomain(hintCell.first, hintCell.second);
-        int value = 0;
-        for (int b : domain) {
-            value = b;
-            break; // Take the first valid value
-        }
+        unsigned int domain = gamePlayer.getBoard()->calculateDomainMask(hintCell.first, hintCell.second);
+        int value = lowestValue(domain); // Take the first valid value
 
         if (value > 0) {
+            // Apply the hint to the model first; setText emits no textEdited, and in pen
+            // mode savemove would ignore the cell anyway
+            gamePlayer.move(hintCell.first, hintCell.second, value);
+
             // Clear any pen marks for this cell
             clearPenMarks(hintCell.first, hintCell.second);
 
             labellist[hintCell.first][hintCell.second]->setText(QString::number(value));
             labellist[hintCell.first][hintCell.second]->setStyleSheet("background-color: green;");
+            checkwinner();
             gamePlayer.incrementHintCount();
             int hintsleft = gamePlayer.getHintCount();
             gethint->setText("Get a Hint ("+QString::number(hintsleft)+"/"+QString::number(maxHints)+" Used)");
@@ -91,60 +106,65 @@ void viewer::gethintpress()
 
 void viewer::backpress()
 {
+    cancelGeneration();
     this->hide();
     this->parentWidget()->show();
 }
-void viewer::savemove()
+void viewer::savemove(int row, int col)
 {
-    static int won = 1;
-
     // Don't process moves in pen mode
     if (isPenMode) return;
 
-    for(auto pos : positions)
+    QLineEdit* cell = labellist[row][col];
+    if (cell->isReadOnly() || !cell->isEnabled()) return;
+
+    QString cellText = cell->text();
+    if(cellText == "")
     {
-        if(labellist[pos.first][pos.second]->text() == "")
-        {
-            // If the cell is empty, remove the value from the game model
-            int currentValue = gamePlayer.getBoard()->getValue(pos.first, pos.second);
-            if(currentValue != 0) {
-                gamePlayer.remove(pos.first, pos.second);
-                clearPenMarks(pos.first, pos.second);
-            }
+        // If the cell is empty, remove the value from the game model
+        int currentValue = gamePlayer.getBoard()->getValue(row, col);
+        if(currentValue != 0) {
+            gamePlayer.remove(row, col);
+            clearPenMarks(row, col);
         }
-        else if(labellist[pos.first][pos.second]->text() != "0")
-        {
-            // Only process if the text is a single digit (not pen marks)
-            QString cellText = labellist[pos.first][pos.second]->text();
-            if (cellText.length() == 1) {
-                int val = cellText.toInt();
-                if (val < 1 || val > 9)
-                {
-                    labellist[pos.first][pos.second]->setText("");
-                }
-                else
+    }
+    else if(cellText != "0")
+    {
+        // Only process if the text is a single digit (not pen marks)
+        if (cellText.length() == 1) {
+            int val = cellText.toInt();
+            if (val < 1 || val > 9)
+            {
+                cell->setText("");
+            }
+            else
+            {
+                int current = gamePlayer.getBoard()->board[row][col];
+                if(val != current)
                 {
-                    int cell = gamePlayer.getBoard()->board[pos.first][pos.second];
-                    if(val != cell)
+                    if (!(gamePlayer.getBoard()->calculateDomainMask(row, col) & maskBit(val)))
                     {
-                        unorderedSet domain = gamePlayer.getBoard()->calculateDomain(pos.first, pos.second);
-                        if (!domain.contains(val))
-                        {
-                            labellist[pos.first][pos.second]->setText("");
-                            gamePlayer.moveCount++;
-                        }
-                        else
-                        {
-                            gamePlayer.move(pos.first, pos.second, val);
-                            // Clear any pen marks for this cell after a move
-                            clearPenMarks(pos.first, pos.second);
-                        }
+                        cell->setText("");
+                        gamePlayer.moveCount++;
+                    }
+                    else
+                    {
+                        gamePlayer.move(row, col, val);
+                        // Clear any pen marks for this cell after a move
+                        clearPenMarks(row, col);
                     }
                 }
             }
         }
     }
 
+    checkwinner();
+}
+
+void viewer::checkwinner()
+{
+    static int won = 1;
+
     if(gamePlayer.checkwin())
     {
         if(won == 1)
@@ -178,8 +198,6 @@ void viewer::clearAllPenMarks()
 }
 void viewer::loadboard()
 {
-    positions.clear(); // Clear previous positions
-
     for(int i = 0; i < 9; i++)
     {
         for(int j = 0; j < 9; j++)
@@ -193,12 +211,74 @@ void viewer::loadboard()
             else
             {
                 labellist[i][j]->setText(""); // Initialize empty cells with empty string
-                positions.push_back(make_pair(i,j));
+                labellist[i][j]->setDisabled(false);
             }
         }
     }
 }
 
+void viewer::startGeneration()
+{
+    setLoading(true);
+
+    job = std::make_shared<GenerationJob>();
+    std::shared_ptr<GenerationJob> work = job;
+    int d = diff;
+    SudokuSolver::Strategy strategy = gamePlayer.getSolverStrategy();
+
+    generationWatcher = new QFutureWatcher<bool>(this);
+    connect(generationWatcher, &QFutureWatcher<bool>::finished, this, &viewer::generationFinished);
+    generationWatcher->setFuture(QtConcurrent::run([work, d, strategy]() {
+        return player::generatePuzzle(d, strategy, work->puzzle, &work->cancel, &work->progress);
+    }));
+}
+
+void viewer::generationFinished()
+{
+    bool generated = generationWatcher->result();
+    generationWatcher->deleteLater();
+    generationWatcher = nullptr;
+
+    if (!job || job->cancel || !generated)
+    {
+        job.reset();
+        return; // Abandoned
+    }
+
+    gamePlayer.startgame(diff, job->puzzle);
+    job.reset();
+    setLoading(false);
+    loadboard();
+}
+
+void viewer::cancelGeneration()
+{
+    // The worker stops at its next check; generationFinished then drops the result
+    if (job)
+    {
+        job->cancel = true;
+    }
+}
+
+void viewer::setLoading(bool x)
+{
+    loading = x;
+    gethint->setDisabled(x);
+    penModeButton->setDisabled(x);
+    clearPenButton->setDisabled(x);
+    if (x)
+    {
+        // Placeholder grid until the puzzle arrives
+        for (int i = 0; i < 9; i++) {
+            for (int j = 0; j < 9; j++) {
+                labellist[i][j]->setText("");
+                labellist[i][j]->setDisabled(true);
+            }
+        }
+        time->setText("Generating 0%");
+    }
+}
+
 void viewer::setdifficulity(int x)
 {
     diff = x;
@@ -216,19 +296,11 @@ bool viewer::eventFilter(QObject* obj, QEvent* event)
         QLineEdit* cell = qobject_cast<QLineEdit*>(obj);
 
         if (cell) {
-            // Find the row and column of this cell
-            int row = -1, col = -1;
-            for (int i = 0; i < 9 && row == -1; i++) {
-                for (int j = 0; j < 9; j++) {
-                    if (labellist[i][j] == cell) {
-                        row = i;
-                        col = j;
-                        break;
-                    }
-                }
-            }
+            // Row and column stored on the cell by initUI
+            int row = cell->property("row").toInt();
+            int col = cell->property("col").toInt();
 
-            if (row != -1 && !cell->isReadOnly()) {
+            if (!cell->isReadOnly()) {
                 int key = keyEvent->key();
 
                 // Handle backspace and delete keys
@@ -303,6 +375,9 @@ void viewer::initUI()
             // labellist[i][j]->setText("0");
             labellist[i][j]->setAlignment(Qt::AlignCenter);  // Center the text
             labellist[i][j]->installEventFilter(this);
+            labellist[i][j]->setProperty("row", i);
+            labellist[i][j]->setProperty("col", j);
+            connect(labellist[i][j], &QLineEdit::textEdited, this, [this, i, j]() { savemove(i, j); });
         }
     }
 
@@ -6,10 +6,13 @@
 #include <QLabel>
 #include <QLineEdit>
 #include <QTimer>
+#include <QFutureWatcher>
 
 #include <sudokuboard.h>
 #include <player.h>
 #include <set>
+#include <atomic>
+#include <memory>
 
 using namespace std;
 
@@ -23,13 +26,33 @@ public:
     void setdifficulity(int x);
     int diff;
     void loadboard();
-    void savemove();
-    vector<pair<int,int>> positions;
 
-    //update
+    // Apply the text of one cell to the game model and check for a win
+    void savemove(int row, int col);
+
+    // Show the victory popup (once) when the model is solved
+    void checkwinner();
+
+    //update: the timer only drives the clock and score labels; input arrives
+    // through each cell's textEdited signal
     QTimer *timer;
     void update();
 
+    // Puzzle generation on a worker thread; the grid stays a disabled placeholder until
+    // it finishes. The job is shared with the worker so it outlives a closed viewer.
+    struct GenerationJob {
+        std::atomic<bool> cancel{false};
+        std::atomic<int> progress{0};
+        PuzzleGrid puzzle;
+    };
+    std::shared_ptr<GenerationJob> job;
+    QFutureWatcher<bool>* generationWatcher = nullptr;
+    bool loading = false;
+    void startGeneration();
+    void generationFinished();
+    void cancelGeneration();
+    void setLoading(bool x);
+
     int maxHints =0;
     // ui functions
 